@@ -26,6 +26,10 @@ int main()
 			return '#';
 		case pmg::TileType::Door:
 			return 'D';
+		case pmg::TileType::UpStair:
+			return '<';
+		case pmg::TileType::DownStair:
+			return '>';
 		}
 
 		return '?';
@@ -1,11 +1,18 @@
 #pragma once
 #include <random>
 #include <algorithm>
+#include <limits>
 #include "types.h"
+#include "random.h"
+#include "validator.h"
+#include "control.h"
+#include "mapView.h"
+#include "trace.h"
+#include "hash.h"
 
 namespace pmg
 {
-class Agent
+class Agent : public TileMap
 {
 	struct Node
 	{
@@ -15,22 +22,118 @@ class Agent
 		Direction mDir;
 		int mX;
 		int mY;
+		Rectangle mArea; //  δ  ʴ´
+		int mAge; //  
 	};
 
 public:
 	Agent(int width, int height, int agentNum, int energy, float rotateDelta, float digDelta)
-		:mWidth(width), mHeight(height),
+		:TileMap(width, height),
 		mAgentNum(agentNum), mEnergy(energy),
 		mRotateDelta(rotateDelta), mDigDelta(digDelta)
 	{
-		mData.resize(mWidth*mHeight, TileType::Wall);
 	}
 
 	template<typename RandomGenerator = std::mt19937>
 	void createMap()
 	{
 		std::random_device rd;
-		RandomGenerator generator(rd());
+		createMap<RandomGenerator>(rd());
+	}
+
+	//setControl ѱ ū ҵǸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		return generate<RandomGenerator>(seed, nullptr);
+	}
+
+	// ĭ    ִ ִ  Ѿ ٷ ߰ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed, const MapConstraint& constraint)
+	{
+		return generate<RandomGenerator>(seed, &constraint);
+	}
+
+	//õ带 ٲ㰡 constraint ϴ    ִ tryNum õѴ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createValidMap(const MapConstraint& constraint, int tryNum)
+	{
+		std::random_device rd;
+
+		for (int i = 0; i < tryNum; i++)
+		{
+			if (createMap<RandomGenerator>(rd(), constraint))
+				return true;
+		}
+
+		return false;
+	}
+
+	//̹  data  starts Ʈ ϳ ΰ,   areas ȿ Ǵ.
+	//ռ ο   ü Ÿ ۿ agentNum  ʴ´.
+	template<typename RandomGenerator>
+	bool dig(TileBuffer& data, int width, const std::vector<Point>& starts,
+		const std::vector<Rectangle>& areas, RandomGenerator& generator)
+	{
+		std::vector<Node> agents;
+		std::uniform_int_distribution<int> dirDist(0, 3);
+
+		for (size_t i = 0; i < starts.size(); i++)
+		{
+			Node node;
+
+			node.mEnergy = mEnergy;
+			node.mRotate = 0.0f;
+			node.mDig = 0.0f;
+			node.mDir = static_cast<Direction>(dirDist(generator));
+			node.mX = starts[i].mX;
+			node.mY = starts[i].mY;
+			node.mArea = areas[i];
+			node.mAge = 0;
+
+			agents.push_back(node);
+		}
+
+		return walk(data.data(), width, agents, generator, std::numeric_limits<std::int64_t>::max());
+	}
+
+	//createMap  ϴ  ؽ.
+	std::uint64_t getParamHash() const
+	{
+		Fnv1a hash;
+
+		hash.addString("Agent");
+		hash.add(mWidth);
+		hash.add(mHeight);
+		hash.add(mAgentNum);
+		hash.add(mEnergy);
+		hash.add(mRotateDelta);
+		hash.add(mDigDelta);
+
+		return hash.get();
+	}
+
+	// ϸ Ȯϴ  ū Ҹ     ݹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+private:
+	template<typename RandomGenerator>
+	bool generate(unsigned int seed, const MapConstraint* constraint)
+	{
+		if (!isValid())
+			return false;
+
+		RandomGenerator generator(seed);
+
+		std::fill(mData.begin(), mData.end(), TileType::Wall);
+
+		//  ִ ĭ þ⸸ ϹǷ      ʿ䰡 .
+		std::int64_t maxWalkable = static_cast<std::int64_t>(mWidth) * mHeight;
+
+		if (constraint != nullptr)
+			maxWalkable = static_cast<std::int64_t>(constraint->mMaxWalkableRate * mWidth * mHeight);
 
 		std::vector<Node> agents;
 
@@ -39,25 +142,71 @@ public:
 			agents.push_back(createNode(generator));
 		}
 
+		if (!walk(mData.data(), mWidth, agents, generator, maxWalkable))
+			return false;
+
+		return constraint == nullptr || constraint->isSatisfied(computeStats(getView()));
+	}
+
+	//Ʈ      data Ǵ. ҵǰų  ĭ maxWalkable  false.
+	template<typename RandomGenerator>
+	bool walk(TileType* data, int width, std::vector<Node>& agents, RandomGenerator& generator, std::int64_t maxWalkable)
+	{
+		PMG_TRACE_SCOPE("Agent::walk");
+
+		typedef RandomTraits<RandomGenerator> Traits;
+
+		//Ʈ   Ʈ. Ʈ ϴ  Ʈ ̴.
+		std::vector<typename Traits::Stream> streams;
+		std::int64_t totalEnergy = 0; //Ʈ  x  int   ִ
+
+		for (size_t i = 0; i < agents.size(); i++)
+		{
+			streams.push_back(Traits::makeStream(generator, i));
+			totalEnergy += agents[i].mEnergy;
+		}
+
+		totalEnergy = std::max<std::int64_t>(1, totalEnergy);
+
 		std::uniform_real_distribution<float> probDist(0.0f, 1.0f);
 		std::uniform_int_distribution<int> clockwiseDist(0, 1);
 
+		std::int64_t walkable = 0;
+		std::int64_t usedEnergy = 0;
+		int reportedPercent = 0;
+
 		while (!agents.empty())
 		{
+			if (mControl.isCancelled())
+				return false;
+
+			//ݹ  ̱  1% θ ˸.
+			int percent = static_cast<int>(usedEnergy * 100 / totalEnergy);
+
+			if (percent != reportedPercent)
+			{
+				reportedPercent = percent;
+				mControl.report(percent / 100.0f);
+			}
+
 			for (int i = 0; i < static_cast<int>(agents.size());)
 			{
 				if (agents[i].mEnergy <= 0)
 				{
+					PMG_TRACE_HISTOGRAM("agent.lifetime", agents[i].mAge);
 					agents.erase(agents.begin() + i);
+					streams.erase(streams.begin() + i);
 					continue;
 				}
 
-				if (probDist(generator) < agents[i].mRotate)
+				agents[i].mAge++;
+
+				if (probDist(streams[i]) < agents[i].mRotate)
 				{
 					//ð  ȯ
-					if (clockwiseDist(generator) == 1)
+					if (clockwiseDist(streams[i]) == 1)
 					{
-						agents[i].mDir = static_cast<Direction>((static_cast<int>(agents[i].mDir) + 1) % 3);
+						agents[i].mDir = static_cast<Direction>((static_cast<int>(agents[i].mDir) + 1) % 4);
 					}
 					else // ݽð
 					{
@@ -73,13 +222,14 @@ public:
 
 					agents[i].mEnergy--;
 					agents[i].mRotate = 0.0f;
+					usedEnergy++;
 				}
 				else
 				{
 					agents[i].mRotate += mRotateDelta;
 				}
 
-				if (probDist(generator) < agents[i].mDig)
+				if (probDist(streams[i]) < agents[i].mDig)
 				{
 					Point next(agents[i].mX, agents[i].mY);
 
@@ -99,15 +249,22 @@ public:
 						break;
 					}
 
-					//ȭ Ѿ  
-					if (next.mX < 0 || next.mY < 0 || next.mX >= mWidth || next.mY >= mHeight)
+					// Ѿ  
+					if (!agents[i].mArea.isContain(next))
+					{
+						PMG_TRACE_COUNT("agent.blocked", 1);
 						continue;
+					}
 
-					if (mData[next.mX + next.mY * mWidth] == TileType::Wall)
+					if (data[toIndex(next.mX, next.mY, width)] == TileType::Wall)
 					{
-						mData[next.mX + next.mY * mWidth] = TileType::Room;
+						data[toIndex(next.mX, next.mY, width)] = TileType::Room;
 						agents[i].mEnergy--;
 						agents[i].mDig = 0.0f;
+						usedEnergy++;
+
+						if (++walkable > maxWalkable)
+							return false;
 					}
 
 					agents[i].mX = next.mX;
@@ -121,13 +278,12 @@ public:
 				i++;
 			}
 		}
-	}
 
-	int getWidth() const { return mWidth; }
-	int getHeight() const { return mHeight; }
-	TileType getData(int x, int y) const { return mData[x + y*mWidth]; }
+		mControl.report(1.0f);
+
+		return true;
+	}
 
-private:
 	template<typename RandomGenerator>
 	Node createNode(RandomGenerator& generator)
 	{
@@ -145,17 +301,17 @@ private:
 
 		res.mX = xDist(generator);
 		res.mY = yDist(generator);
+		res.mArea = Rectangle(0, 0, mWidth, mHeight);
+		res.mAge = 0;
 
 		return res;
 	}
 
-	int mWidth;
-	int mHeight;
 	int mAgentNum;
 	int mEnergy;
 	float mRotateDelta;
 	float mDigDelta;
-	std::vector<TileType> mData;
+	GenerationControl mControl;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "agentSwarm.h"
+
+//Direction (Top, Right, Bottom, Left)  ĭ ̵.
+static const int DIR_X[4] = { 0, 1, 0, -1 };
+static const int DIR_Y[4] = { -1, 0, 1, 0 };
+
+//SplitMix64  ܰ. Ʈ ¸ 迭 ״ ΰ    д.
+static std::uint64_t nextRandom(std::uint64_t& state)
+{
+	return pmg::SplitMix64::mix(state += 0x9E3779B97F4A7C15ull);
+}
+
+//21Ʈ [0, 1) Ǽ ٲ۴.
+static float toUnit(std::uint64_t bits)
+{
+	return static_cast<float>(bits & 0x1FFFFF) * (1.0f / (1 << 21));
+}
+
+bool pmg::AgentSwarm::walk(std::int64_t maxWalkable)
+{
+	PMG_TRACE_SCOPE("AgentSwarm::walk");
+
+	int liveNum = mAgentNum;
+	std::int64_t walkable = 0;
+	std::int64_t usedEnergy = 0;
+	std::int64_t totalEnergy = std::max<std::int64_t>(1, static_cast<std::int64_t>(mAgentNum) * mEnergy);
+	int reportedPercent = 0;
+
+	liveNum = removeDead(liveNum);
+
+	while (liveNum > 0)
+	{
+		if (mControl.isCancelled())
+			return false;
+
+		//ݹ  ̱  1% θ ˸.
+		int percent = static_cast<int>(usedEnergy * 100 / totalEnergy);
+
+		if (percent != reportedPercent)
+		{
+			reportedPercent = percent;
+			mControl.report(percent / 100.0f);
+		}
+
+		usedEnergy += moveAll(liveNum);
+		walkable += digAll(liveNum, usedEnergy);
+
+		if (walkable > maxWalkable)
+			return false;
+
+		liveNum = removeDead(liveNum);
+	}
+
+	mControl.report(1.0f);
+
+	return true;
+}
+
+int pmg::AgentSwarm::moveAll(int liveNum)
+{
+	//Ʈ б   길 ϵ   0/1  ٷ.
+	//ٷ  ĭ   ߶ а,  ̸  ƴ  .
+	const TileType* data = mData.data();
+	int width = mWidth;
+	int height = mHeight;
+	float rotateDelta = mRotateDelta;
+	float digDelta = mDigDelta;
+	float exploreBias = mExploreBias;
+	int turnNum = 0;
+
+	for (int i = 0; i < liveNum; i++)
+	{
+		std::uint64_t bits = nextRandom(mStates[i]);
+		float turnRoll = toUnit(bits);
+		float digRoll = toUnit(bits >> 21);
+		float biasRoll = toUnit(bits >> 42);
+		int isClockwise = static_cast<int>(bits >> 63);
+
+		int x = mXs[i];
+		int y = mYs[i];
+		int dir = mDirs[i];
+		int cw = (dir + 1) & 3;
+		int ccw = (dir + 3) & 3;
+
+		int cwX = x + DIR_X[cw];
+		int cwY = y + DIR_Y[cw];
+		int ccwX = x + DIR_X[ccw];
+		int ccwY = y + DIR_Y[ccw];
+		int isCwInside = cwX >= 0 && cwX < width && cwY >= 0 && cwY < height;
+		int isCcwInside = ccwX >= 0 && ccwX < width && ccwY >= 0 && ccwY < height;
+		std::size_t cwIdx = toIndex(std::min(std::max(cwX, 0), width - 1), std::min(std::max(cwY, 0), height - 1), width);
+		std::size_t ccwIdx = toIndex(std::min(std::max(ccwX, 0), width - 1), std::min(std::max(ccwY, 0), height - 1), width);
+		int isCwWall = isCwInside & (data[cwIdx] == TileType::Wall);
+		int isCcwWall = isCcwInside & (data[ccwIdx] == TileType::Wall);
+
+		//ʸ ̸ bias Ȯ  .
+		int isBiased = (biasRoll < exploreBias) & (isCwWall != isCcwWall);
+		int toCw = isBiased ? isCwWall : isClockwise;
+
+		int isTurn = turnRoll < mRotates[i];
+
+		dir = isTurn ? (toCw ? cw : ccw) : dir;
+		mDirs[i] = dir;
+		mEnergies[i] -= isTurn;
+		mRotates[i] = isTurn ? 0.0f : mRotates[i] + rotateDelta;
+		turnNum += isTurn;
+
+		int isDig = digRoll < mDigs[i];
+		int nextX = x + DIR_X[dir];
+		int nextY = y + DIR_Y[dir];
+		int isInside = nextX >= 0 && nextX < width && nextY >= 0 && nextY < height;
+
+		mNextXs[i] = nextX;
+		mNextYs[i] = nextY;
+		mMoves[i] = static_cast<char>(isDig & isInside);
+		mDigs[i] = isDig ? mDigs[i] : mDigs[i] + digDelta;
+	}
+
+	return turnNum;
+}
+
+int pmg::AgentSwarm::digAll(int liveNum, std::int64_t& usedEnergy)
+{
+	int dugNum = 0;
+
+	for (int i = 0; i < liveNum; i++)
+	{
+		if (!mMoves[i])
+			continue;
+
+		int x = mNextXs[i];
+		int y = mNextYs[i];
+		int dug = digSquare(x, y, mCorridorWidth);
+
+		mXs[i] = x;
+		mYs[i] = y;
+
+		if (dug == 0)
+			continue;
+
+		mEnergies[i]--;
+		mDigs[i] = 0.0f;
+		usedEnergy++;
+
+		//  ĭ  Ʈ Ƿ  ׶  ̴´.
+		if (mRoomChance > 0.0f)
+		{
+			std::uint64_t bits = nextRandom(mStates[i]);
+
+			if (toUnit(bits) < mRoomChance)
+			{
+				int range = mRoomSizeMax - mRoomSizeMin + 1;
+
+				dug += digSquare(x, y, mRoomSizeMin + static_cast<int>((bits >> 21) % range));
+				PMG_TRACE_COUNT("swarm.room", 1);
+			}
+		}
+
+		dugNum += dug;
+	}
+
+	return dugNum;
+}
+
+int pmg::AgentSwarm::digSquare(int x, int y, int size)
+{
+	int left = std::max(0, x - (size - 1) / 2);
+	int top = std::max(0, y - (size - 1) / 2);
+	int right = std::min(mWidth, x + size / 2 + 1);
+	int bottom = std::min(mHeight, y + size / 2 + 1);
+	int dug = 0;
+
+	for (int py = top; py < bottom; py++)
+	{
+		for (int px = left; px < right; px++)
+		{
+			TileType& tile = mData[toIndex(px, py, mWidth)];
+
+			dug += tile == TileType::Wall;
+			tile = TileType::Room;
+		}
+	}
+
+	return dug;
+}
+
+int pmg::AgentSwarm::removeDead(int liveNum)
+{
+	for (int i = 0; i < liveNum;)
+	{
+		if (mEnergies[i] > 0)
+		{
+			i++;
+			continue;
+		}
+
+		liveNum--;
+
+		mXs[i] = mXs[liveNum];
+		mYs[i] = mYs[liveNum];
+		mDirs[i] = mDirs[liveNum];
+		mEnergies[i] = mEnergies[liveNum];
+		mRotates[i] = mRotates[liveNum];
+		mDigs[i] = mDigs[liveNum];
+		mStates[i] = mStates[liveNum];
+	}
+
+	return liveNum;
+}
\ No newline at end of file
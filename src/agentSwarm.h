@@ -0,0 +1,180 @@
+#pragma once
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "types.h"
+#include "random.h"
+#include "validator.h"
+#include "control.h"
+#include "mapView.h"
+#include "trace.h"
+#include "hash.h"
+
+namespace pmg
+{
+
+//Ʈ    Agent Ȯ. Ʈ ¸ Ӽ 迭 
+//   Ʈ ȸ ̵ б      Ĵ ͸  óѴ.
+//Agent ۿ   ,  ʺ,         ִ.
+class AgentSwarm : public TileMap
+{
+public:
+	AgentSwarm(int width, int height, int agentNum, int energy, float rotateDelta, float digDelta)
+		:TileMap(width, height),
+		mAgentNum(agentNum), mEnergy(energy),
+		mRotateDelta(rotateDelta), mDigDelta(digDelta)
+	{
+	}
+
+	template<typename RandomGenerator = std::mt19937>
+	void createMap()
+	{
+		std::random_device rd;
+		createMap<RandomGenerator>(rd());
+	}
+
+	//setControl ѱ ū ҵǸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		return generate<RandomGenerator>(seed, nullptr);
+	}
+
+	// ĭ    ִ ִ  Ѿ ٷ ߰ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed, const MapConstraint& constraint)
+	{
+		return generate<RandomGenerator>(seed, &constraint);
+	}
+
+	// ĭ   chance Ȯ  ڸ  ϴ sizeMin ~ sizeMax ũ  Ǵ.
+	void setRoomDrop(float chance, int sizeMin, int sizeMax)
+	{
+		mRoomChance = chance;
+		mRoomSizeMin = std::max(1, sizeMin);
+		mRoomSizeMax = std::max(mRoomSizeMin, sizeMax);
+	}
+
+	//  width * width ĭ Ǵ.
+	void setCorridorWidth(int width) { mCorridorWidth = std::max(1, width); }
+
+	//  bias Ȯ    ٷ    .   ̰ų   ƴϸ .
+	void setExploreBias(float bias) { mExploreBias = bias; }
+
+	//createMap  ϴ  ؽ.
+	std::uint64_t getParamHash() const
+	{
+		Fnv1a hash;
+
+		hash.addString("AgentSwarm");
+		hash.add(mWidth);
+		hash.add(mHeight);
+		hash.add(mAgentNum);
+		hash.add(mEnergy);
+		hash.add(mRotateDelta);
+		hash.add(mDigDelta);
+		hash.add(mRoomChance);
+		hash.add(mRoomSizeMin);
+		hash.add(mRoomSizeMax);
+		hash.add(mCorridorWidth);
+		hash.add(mExploreBias);
+
+		return hash.get();
+	}
+
+	// ϸ Ȯϴ  ū Ҹ     ݹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+private:
+	template<typename RandomGenerator>
+	bool generate(unsigned int seed, const MapConstraint* constraint)
+	{
+		PMG_TRACE_SCOPE("AgentSwarm::createMap");
+
+		if (!isValid())
+			return false;
+
+		RandomGenerator generator(seed);
+		std::uniform_int_distribution<int> dirDist(0, 3);
+		std::uniform_int_distribution<int> xDist(0, mWidth - 1);
+		std::uniform_int_distribution<int> yDist(0, mHeight - 1);
+
+		std::fill(mData.begin(), mData.end(), TileType::Wall);
+
+		mXs.resize(mAgentNum);
+		mYs.resize(mAgentNum);
+		mDirs.resize(mAgentNum);
+		mEnergies.assign(mAgentNum, mEnergy);
+		mRotates.assign(mAgentNum, 0.0f);
+		mDigs.assign(mAgentNum, 0.0f);
+		mStates.resize(mAgentNum);
+		mNextXs.resize(mAgentNum);
+		mNextYs.resize(mAgentNum);
+		mMoves.resize(mAgentNum);
+
+		//Ʈ generator   SplitMix64 ¸  ϸ   ̴´.
+		for (int i = 0; i < mAgentNum; i++)
+		{
+			mDirs[i] = dirDist(generator);
+			mXs[i] = xDist(generator);
+			mYs[i] = yDist(generator);
+			mStates[i] = SplitMix64::mix(static_cast<std::uint64_t>(generator()) ^ SplitMix64::mix(i));
+		}
+
+		//  ִ ĭ þ⸸ ϹǷ      ʿ䰡 .
+		std::int64_t maxWalkable = static_cast<std::int64_t>(mWidth) * mHeight;
+
+		if (constraint != nullptr)
+			maxWalkable = static_cast<std::int64_t>(constraint->mMaxWalkableRate * mWidth * mHeight);
+
+		if (!walk(maxWalkable))
+			return false;
+
+		return constraint == nullptr || constraint->isSatisfied(computeStats(getView()));
+	}
+
+	// ִ Ʈ    ݺѴ. ҵǰų  ĭ maxWalkable  false.
+	bool walk(std::int64_t maxWalkable);
+
+	// ִ  liveNum Ʈ ȸ, ̵ ĭ Ѳ Ѵ.  Ʈ  ȯ.
+	int moveAll(int liveNum);
+
+	//moveAll ̱  Ʈ ĭ İ ڸ ű.   ĭ  ȯ.
+	// ĭ  Ʈ  usedEnergy Ѵ.
+	int digAll(int liveNum, std::int64_t& usedEnergy);
+
+	//(x, y)  ϴ size * size ĭ Ǵ.   ĭ  ȯ.
+	int digSquare(int x, int y, int size);
+
+	//   Ʈ   Ʈ ٲ㼭 ش.  Ʈ  ȯ.
+	int removeDead(int liveNum);
+
+	int mAgentNum;
+	int mEnergy;
+	float mRotateDelta;
+	float mDigDelta;
+	float mRoomChance = 0.0f;
+	int mRoomSizeMin = 3;
+	int mRoomSizeMax = 5;
+	int mCorridorWidth = 1;
+	float mExploreBias = 0.0f;
+	GenerationControl mControl;
+
+	//Ʈ i .  liveNum  ִ.
+	std::vector<int> mXs;
+	std::vector<int> mYs;
+	std::vector<int> mDirs; //Direction 
+	std::vector<int> mEnergies;
+	std::vector<float> mRotates;
+	std::vector<float> mDigs;
+	std::vector<std::uint64_t> mStates;
+
+	//moveAll 
+	std::vector<int> mNextXs;
+	std::vector<int> mNextYs;
+	std::vector<char> mMoves;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include <future>
+#include <random>
+#include "control.h"
+
+namespace pmg
+{
+
+//generator.createMap(seed)  忡 . 
+// ϷǸ true, control ū ҵǸ false.   generator ǵ帮  ȴ.
+template<typename RandomGenerator = std::mt19937, typename Generator>
+std::future<bool> createMapAsync(Generator& generator, unsigned int seed, const GenerationControl& control)
+{
+	generator.setControl(control);
+
+	return std::async(std::launch::async, [&generator, seed]()
+	{
+		return generator.template createMap<RandomGenerator>(seed);
+	});
+}
+
+template<typename RandomGenerator = std::mt19937, typename Generator>
+std::future<bool> createMapAsync(Generator& generator, const GenerationControl& control)
+{
+	std::random_device rd;
+
+	return createMapAsync<RandomGenerator>(generator, rd(), control);
+}
+
+}
\ No newline at end of file
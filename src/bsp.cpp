@@ -1,6 +1,6 @@
 #include "bsp.h"
 
-void pmg::Leaf::fillData(int width, int height, std::vector<TileType>& data)
+void pmg::Leaf::fillData(int width, int height, TileType* data)
 {
 	if (mLeftChild != nullptr)
 		mLeftChild->fillData(width, height, data);
@@ -10,7 +10,7 @@ void pmg::Leaf::fillData(int width, int height, std::vector<TileType>& data)
 
 	for (auto& p : mHallways)
 	{
-		data[p.mX + p.mY * width] = TileType::Hall;
+		data[toIndex(p.mX, p.mY, width)] = TileType::Hall;
 	}
 
 	if (!hasChild())
@@ -19,6 +19,53 @@ void pmg::Leaf::fillData(int width, int height, std::vector<TileType>& data)
 	}
 }
 
+int pmg::Leaf::getLeafNum() const
+{
+	if (!hasChild())
+		return 1;
+
+	int res = 0;
+
+	if (mLeftChild != nullptr)
+		res += mLeftChild->getLeafNum();
+
+	if (mRightChild != nullptr)
+		res += mRightChild->getLeafNum();
+
+	return res;
+}
+
+std::int64_t pmg::Leaf::getRoomInnerArea() const
+{
+	if (!hasChild())
+		return static_cast<std::int64_t>(std::max(0, mRoom.mWidth - 2)) * std::max(0, mRoom.mHeight - 2);
+
+	std::int64_t res = 0;
+
+	if (mLeftChild != nullptr)
+		res += mLeftChild->getRoomInnerArea();
+
+	if (mRightChild != nullptr)
+		res += mRightChild->getRoomInnerArea();
+
+	return res;
+}
+
+void pmg::Leaf::getLeafRooms(OUT std::vector<Room*>& rooms)
+{
+	if (!hasChild())
+	{
+		rooms.push_back(&mRoom);
+		return;
+	}
+
+	if (mLeftChild != nullptr)
+		mLeftChild->getLeafRooms(rooms);
+
+	if (mRightChild != nullptr)
+		mRightChild->getLeafRooms(rooms);
+}
+
 void pmg::Leaf::getSideRoom(Direction type, OUT std::vector<Room*>& rooms)
 {
 	if (!hasChild())
@@ -179,65 +226,50 @@ bool pmg::Leaf::isValidHallpos(const Point & pos, Direction side, Rectangle area
 	return false;
 }
 
-bool pmg::Rectangle::isConnect(const Rectangle & other) const
+bool pmg::Leaf::isWideHallpos(const Point& pos, const std::vector<Point>& hallways)
 {
-	if (mX == other.getRight() + 1 ||
-		other.mX == getRight() + 1)
-	{
-		return (mY >= other.mY && mY < other.getBottom() - 1) ||
-			(other.mY >= mY && other.mY < getBottom() - 1);
-	}
+	if (isContainPoint(hallways, pos))
+		return false;
 
-	if (mY == other.mY + other.mHeight ||
-		other.mY == mY + mHeight)
+	for (int dy = -1; dy <= 1; dy += 2)
 	{
-		return (mX >= other.mX && mX < other.getRight() - 1) ||
-			(other.mX >= mX && other.mX < getRight() - 1);
+		for (int dx = -1; dx <= 1; dx += 2)
+		{
+			if (isContainPoint(hallways, pos.mX + dx, pos.mY) && isContainPoint(hallways, pos.mX, pos.mY + dy) &&
+				isContainPoint(hallways, pos.mX + dx, pos.mY + dy))
+			{
+				return true;
+			}
+		}
 	}
 
 	return false;
 }
 
-bool pmg::Rectangle::isContain(const Point & pos) const
-{
-	return pos.mX >= mX && pos.mX <= getRight() &&
-		pos.mY >= mY && pos.mY <= getBottom();
-}
-
-void pmg::Room::fillData(int width, int height, std::vector<TileType>& data)
+void pmg::Room::fillData(int width, int height, TileType* data) const
 {
-	if (mIsVisited)
-		return;
-	
-	std::vector<Room*> allRooms = getAllRooms();
-
-	for (auto r : allRooms)
+	for (int y = mY; y < getBottom() + 1; y++)
 	{
-		const auto& room = *r;
-
-		for (int y = room.mY; y < room.getBottom() + 1; y++)
+		for (int x = mX; x < getRight() + 1; x++)
 		{
-			for (int x = room.mX; x < room.getRight() + 1; x++)
+			if (isWallPos(x, y))
+			{
+				data[toIndex(x, y, width)] = TileType::Wall;
+			}
+			else
 			{
-				if (isWallPos(x, y, width, height, allRooms))
-				{
-					data[x + y*width] = TileType::Wall;
-				}
-				else
-				{
-					data[x + y * width] = TileType::Room;
-				}
+				data[toIndex(x, y, width)] = TileType::Room;
 			}
 		}
+	}
 
-		for (auto& door : room.mDoors)
-		{
-			data[door.mX + door.mY * width] = TileType::Door;
-		}
+	for (auto& door : mDoors)
+	{
+		data[toIndex(door.mX, door.mY, width)] = TileType::Door;
 	}
 }
 
-bool pmg::Room::isWallPos(int x, int y, int width, int height, const std::vector<Room*>& rooms)
+bool pmg::Room::isWallPos(int x, int y) const
 {
 	Point adjs[8] = 
 	{ 
@@ -253,43 +285,203 @@ bool pmg::Room::isWallPos(int x, int y, int width, int height, const std::vector
 
 	for (int i = 0; i < 8; i++)
 	{
-		const Point& adj = adjs[i];
-		if (std::all_of(rooms.begin(), rooms.end(), [&adj](const Room* room)
-		{
-			return !room->isContain(adj);
-		}))
-		{
+		//κ ڱ 簢 ̹Ƿ   ʴ´.
+		if (!isContain(adjs[i]) && !isGroupContain(adjs[i]))
 			return true;
-		}
 	}
 
 	return false;
 }
 
-std::vector<pmg::Room*> pmg::Room::getAllRooms()
+bool pmg::Room::isGroupContain(const Point& pos) const
+{
+	const Room* now = this;
+
+	do
+	{
+		if (now->isContain(pos))
+			return true;
+
+		now = now->getGroupNext();
+	} while (now != this);
+
+	return false;
+}
+
+void pmg::Room::unite(Room& other)
+{
+	Room* root = getGroupRoot();
+	Room* otherRoot = other.getGroupRoot();
+
+	if (root == otherRoot)
+		return;
+
+	//    ĭ ¹ٲٸ ϳ  ȴ.
+	Room* next = mGroupNext != nullptr ? mGroupNext : this;
+	Room* otherNext = other.mGroupNext != nullptr ? other.mGroupNext : &other;
+
+	mGroupNext = otherNext;
+	other.mGroupNext = next;
+
+	//rank   Ʒ ٿ getGroup   ̵ ª  Ѵ.
+	if (root->mGroupRank < otherRoot->mGroupRank)
+		std::swap(root, otherRoot);
+
+	otherRoot->mGroupParent = root;
+
+	if (root->mGroupRank == otherRoot->mGroupRank)
+		root->mGroupRank++;
+}
+
+// Ʈ .
+static int countBits(std::uint64_t bits)
 {
-	std::vector<Room*> rooms;
-	std::queue<Room*> queue;
+	bits = bits - ((bits >> 1) & 0x5555555555555555ull);
+	bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+	bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+	return static_cast<int>((bits * 0x0101010101010101ull) >> 56);
+}
+
+int pmg::Room::getSideLength(Direction side) const
+{
+	if (side == Direction::Top || side == Direction::Bottom)
+		return mWidth - 2;
+
+	return mHeight - 2;
+}
+
+void pmg::Room::addDoor(const Point& door)
+{
+	mDoors.push_back(door);
+
+	Direction side;
+	int idx;
+
+	if (door.mY == mY)
+	{
+		side = Direction::Top;
+		idx = door.mX - mX - 1;
+	}
+	else if (door.mY == getBottom())
+	{
+		side = Direction::Bottom;
+		idx = door.mX - mX - 1;
+	}
+	else if (door.mX == mX)
+	{
+		side = Direction::Left;
+		idx = door.mY - mY - 1;
+	}
+	else
+	{
+		side = Direction::Right;
+		idx = door.mY - mY - 1;
+	}
+
+	auto& mask = mDoorMasks[static_cast<int>(side)];
 
-	queue.push(this);
+	if (mask.empty())
+		mask.resize((getSideLength(side) + 63) / 64, 0);
 
-	while (!queue.empty())
+	mask[idx / 64] |= std::uint64_t(1) << (idx % 64);
+}
+
+std::int64_t pmg::Room::getHeapBytes() const
+{
+	std::size_t bytes = mConnectedRooms.capacity() * sizeof(Room*) + mDoors.capacity() * sizeof(Point);
+
+	for (auto& mask : mDoorMasks)
 	{
-		auto now = queue.front();
-		queue.pop();
+		bytes += mask.capacity() * sizeof(std::uint64_t);
+	}
+
+	return static_cast<std::int64_t>(bytes);
+}
 
-		now->mIsVisited = true;
+std::uint64_t pmg::Room::getCandMask(Direction side, int word) const
+{
+	const auto& mask = mDoorMasks[static_cast<int>(side)];
+	int length = getSideLength(side);
+	int wordNum = (length + 63) / 64;
 
-		rooms.push_back(now);
+	//  Ʈ ĺ ƴϴ.
+	std::uint64_t valid = ~std::uint64_t(0);
 
-		for (auto adj : now->mConnectedRooms)
+	if (word == wordNum - 1 && length % 64 != 0)
+		valid = (std::uint64_t(1) << (length % 64)) - 1;
+
+	if (mask.empty())
+		return valid;
+
+	//  ĭ . յ 忡 Ѿ Ʈ ģ.
+	std::uint64_t left = mask[word] << 1;
+	std::uint64_t right = mask[word] >> 1;
+
+	if (word > 0)
+		left |= mask[word - 1] >> 63;
+
+	if (word + 1 < wordNum)
+		right |= mask[word + 1] << 63;
+
+	return valid & ~(left | right);
+}
+
+int pmg::Room::getDoorCandNum(Direction side) const
+{
+	int wordNum = (getSideLength(side) + 63) / 64;
+	int res = 0;
+
+	for (int w = 0; w < wordNum; w++)
+	{
+		res += countBits(getCandMask(side, w));
+	}
+
+	return res;
+}
+
+pmg::Point pmg::Room::getDoorCand(Direction side, int idx) const
+{
+	int wordNum = (getSideLength(side) + 63) / 64;
+	int pos = 0;
+
+	for (int w = 0; w < wordNum; w++)
+	{
+		std::uint64_t cand = getCandMask(side, w);
+		int num = countBits(cand);
+
+		if (idx >= num)
+		{
+			idx -= num;
+			continue;
+		}
+
+		//Ʒ Ʈ idx    Ʈ ã ĭ̴.
+		for (int i = 0; i < idx; i++)
 		{
-			if (adj->mIsVisited)
-				continue;
+			cand &= cand - 1;
+		}
+
+		pos = w * 64;
 
-			queue.push(adj);
+		while ((cand & 1) == 0)
+		{
+			cand >>= 1;
+			pos++;
 		}
+
+		break;
 	}
 
-	return rooms;
-}
+	switch (side)
+	{
+	case Direction::Top:
+		return Point(mX + 1 + pos, mY);
+	case Direction::Bottom:
+		return Point(mX + 1 + pos, getBottom());
+	case Direction::Left:
+		return Point(mX, mY + 1 + pos);
+	default:
+		return Point(getRight(), mY + 1 + pos);
+	}
+}
\ No newline at end of file
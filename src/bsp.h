@@ -1,5 +1,8 @@
 #pragma once
 #include <memory>
+#include <future>
+#include <thread>
+#include <cstdint>
 #include <random>
 #include <queue>
 #include <functional>
@@ -7,6 +10,12 @@
 #include <algorithm>
 #include <iterator>
 #include "types.h"
+#include "validator.h"
+#include "control.h"
+#include "mapView.h"
+#include "random.h"
+#include "trace.h"
+#include "hash.h"
 
 #ifndef OUT
 #define OUT
@@ -15,37 +24,75 @@
 namespace pmg
 {
 
-struct Rectangle
+struct Room : Rectangle
 {
-	Rectangle() : mX(0), mY(0), mWidth(0), mHeight(0) { }
-	Rectangle(int x, int y, int width, int height) : mX(x), mY(y), mWidth(width), mHeight(height) { }
+	Room() : Rectangle(), mGroupParent(nullptr), mGroupNext(nullptr), mGroupRank(0) { }
+	Room(int x, int y, int width, int height)
+		: Rectangle(x, y, width, height), mGroupParent(nullptr), mGroupNext(nullptr), mGroupRank(0)
+	{
+	}
 
-	bool isConnect(const Rectangle& other) const;
-	bool isContain(const Point& pos) const;
+	//ڱ 簢  ä.  ¸ ٲ Ƿ  ,  忡 ҷ ȴ.
+	void fillData(int width, int height, TileType* data) const;
 
-	int getRight() const { return mX + mWidth - 1; }
-	int getBottom() const { return mY + mHeight - 1; }
+	//8 ̿  ϳ    ̸ .
+	bool isWallPos(int x, int y) const;
 
-	int mX;
-	int mY;
-	int mWidth;
-	int mHeight;
-};
+	// ߰ϰ    Ʈ Ҵ. mDoors    ̰  Ѵ.
+	void addDoor(const Point& door);
 
-struct Room : Rectangle
-{
-	Room() : Rectangle(), mIsVisited(false) { }
-	Room(int x, int y, int width, int height) : Rectangle(x, y, width, height), mIsVisited(false) { }
-	
-	void fillData(int width, int height, std::vector<TileType>& data);
+	//side     ִ ĭ . 𼭸    ĭ      ĭ.
+	int getDoorCandNum(Direction side) const;
+
+	//side   ĺ  idx°.  (̳ ) .
+	Point getDoorCand(Direction side, int idx) const;
+
+	// پ ִ  (union-find). ǥ  ȯѴ.
+	const Room* getGroup() const
+	{
+		const Room* now = this;
 
-	bool isWallPos(int x, int y, int width, int height, const std::vector<Room*>& rooms);
-	
-	std::vector<Room*> getAllRooms();
+		while (now->mGroupParent != nullptr)
+			now = now->mGroupParent;
+
+		return now;
+	}
+
+	//   .    ̾ ִ.
+	const Room* getGroupNext() const { return mGroupNext != nullptr ? mGroupNext : this; }
+
+	bool isGroupContain(const Point& pos) const;
+
+	//   ģ. Ʈ  ߿ θ.
+	void unite(Room& other);
+
+	//     Ʈ.
+	std::int64_t getHeapBytes() const;
 
 	std::vector<Room*> mConnectedRooms;
 	std::vector<Point> mDoors;
-	bool mIsVisited;
+
+private:
+	Room* getGroupRoot()
+	{
+		Room* now = this;
+
+		while (now->mGroupParent != nullptr)
+			now = now->mGroupParent;
+
+		return now;
+	}
+
+	//nullptr̸ ڱ ڽ. Room  Ǿ ٸ  Ű ʰ Ѵ.
+	Room* mGroupParent;
+	Room* mGroupNext;
+	int mGroupRank;
+
+	int getSideLength(Direction side) const;
+	std::uint64_t getCandMask(Direction side, int word) const;
+
+	//Direction   𼭸  ĭ   Ʈ. ù    .
+	std::vector<std::uint64_t> mDoorMasks[4];
 };
 
 class Leaf
@@ -99,6 +146,41 @@ public:
 		}
 	}
 
+	//Ʈ splitNum ܰ ؼ     Ѵ.
+	//control ޸ ѵ   ܰ踦 ǳʶڴ.
+	template<typename RandomGenerator>
+	void splitTree(int splitNum, float splitRange, RandomGenerator& generator, const GenerationControl* control = nullptr)
+	{
+		std::queue<Leaf*> leaves;
+
+		leaves.push(this);
+
+		for (int i = 0; i < splitNum; i++)
+		{
+			if (isCancelled(control))
+				return;
+
+			int size = leaves.size();
+
+			for (int s = 0; s < size; s++)
+			{
+				auto top = leaves.front();
+				leaves.pop();
+
+				top->split(splitRange, generator);
+
+				if (top->hasChild())
+					chargeMemory(control, 2 * sizeof(Leaf));
+
+				if (top->getLeftChild() != nullptr)
+					leaves.push(top->getLeftChild());
+
+				if (top->getRightChild() != nullptr)
+					leaves.push(top->getRightChild());
+			}
+		}
+	}
+
 	// 忡  ش.    / ʺ sizeMid +- sizeDist ũ⿡ . 
 	template<typename RandomGenerator>
 	void makeRoom(float sizeMid, float sizeRange, RandomGenerator& generator)
@@ -138,8 +220,9 @@ public:
 
 
 	//ҵ     ؼ ϳ  .
+	//control ҵǸ   ǳʶڴ.
 	template<typename RandomGenerator>
-	void merge(int complexity, RandomGenerator& generator)
+	void merge(int complexity, RandomGenerator& generator, const GenerationControl* control = nullptr)
 	{
 		// ڽ .
 		if (!hasChild())
@@ -147,10 +230,103 @@ public:
 
 		// ڽ ڽ  
 		if (mLeftChild != nullptr)
-			mLeftChild->merge(complexity, generator);
+			mLeftChild->merge(complexity, generator, control);
 
 		if (mRightChild != nullptr)
-			mRightChild->merge(complexity, generator);
+			mRightChild->merge(complexity, generator, control);
+
+		mergeChildren(complexity, generator, control);
+	}
+
+	//ڽ Ʈ ο    ,  ,    Ѵ.
+	//depth forkDepth   ڽ Ʈ ٸ 忡 .
+	//Ⱑ 尡 ƴ϶ Ʈ η Ƿ  seed forkDepth   .
+	template<typename RandomGenerator>
+	void build(int splitNum, float splitRange, float sizeMid, float sizeRange, int complexity,
+		std::uint64_t seed, std::uint64_t path, int depth, int forkDepth, const GenerationControl* control = nullptr)
+	{
+		if (isCancelled(control))
+			return;
+
+		RandomGenerator generator(static_cast<unsigned int>(SplitMix64::mix(seed ^ SplitMix64::mix(path))));
+
+		if (depth < splitNum)
+			split(splitRange, generator);
+
+		if (hasChild())
+			chargeMemory(control, 2 * sizeof(Leaf));
+
+		if (!hasChild())
+		{
+			makeRoom(sizeMid, sizeRange, generator);
+			return;
+		}
+
+		// ڽ path * 2,  ڽ path * 2 + 1
+		std::future<void> left;
+
+		if (mLeftChild != nullptr)
+		{
+			Leaf* child = mLeftChild.get();
+			auto task = [=]()
+			{
+				child->build<RandomGenerator>(splitNum, splitRange, sizeMid, sizeRange, complexity,
+					seed, path * 2, depth + 1, forkDepth, control);
+			};
+
+			if (depth < forkDepth)
+				left = std::async(std::launch::async, task);
+			else
+				task();
+		}
+
+		if (mRightChild != nullptr)
+		{
+			mRightChild->build<RandomGenerator>(splitNum, splitRange, sizeMid, sizeRange, complexity,
+				seed, path * 2 + 1, depth + 1, forkDepth, control);
+		}
+
+		if (left.valid())
+			left.get();
+
+		mergeChildren(complexity, generator, control);
+	}
+
+	bool hasChild() const
+	{
+		return mLeftChild != nullptr || mRightChild != nullptr;
+	}
+
+	Leaf* getLeftChild() const
+	{
+		return mLeftChild.get();
+	}
+
+	Leaf* getRightChild() const
+	{
+		return mRightChild.get();
+	}
+
+	void fillData(int width, int height, TileType* data);
+
+	int getLeafNum() const;
+
+	//   .
+	void getLeafRooms(OUT std::vector<Room*>& rooms);
+
+	//  ׵θ    .
+	std::int64_t getRoomInnerArea() const;
+
+	//  ĭ. 帶   ̸̾  ϳ ¿ ̾  .
+	void getAllHallways(OUT std::vector<Point>& hallways);
+
+private:
+	// ڽ Ʈ Ѵ. ڽ Ʈ  ̹ Ǿ ־ Ѵ.
+	template<typename RandomGenerator>
+	void mergeChildren(int complexity, RandomGenerator& generator, const GenerationControl* control)
+	{
+		if (control != nullptr && control->isCancelled())
+			return;
 
 		// ڽ .  ´ ġ   ؼ,      
 		if (mLeftChild == nullptr || mRightChild == nullptr)
@@ -170,6 +346,12 @@ public:
 			mRightChild->getSideRoom(Direction::Top, rightCand);
 		}
 
+		MemoryCharge candCharge(getMemoryScope(control));
+		candCharge.set(static_cast<std::int64_t>((leftCand.capacity() + rightCand.capacity()) * sizeof(Room*)));
+
+		//ϸ鼭 濡 þ    Ʈ Բ ´.
+		std::int64_t roomBytes = getRoomHeapBytes(leftCand) + getRoomHeapBytes(rightCand);
+
 		//̹   ϳ ִٸ pass
 		bool alreadyConnected = false;
 		for (auto& leftRoom : leftCand)
@@ -181,37 +363,19 @@ public:
 					alreadyConnected = true;
 					leftRoom->mConnectedRooms.push_back(rightRoom);
 					rightRoom->mConnectedRooms.push_back(leftRoom);
+					leftRoom->unite(*rightRoom);
 				}
 			}
 		}
 
-		if (alreadyConnected)
-			return;
+		if (!alreadyConnected)
+			connect(complexity, leftCand, rightCand, generator, control);
 
-		connect(complexity, leftCand, rightCand, generator);
+		chargeMemory(control, getRoomHeapBytes(leftCand) + getRoomHeapBytes(rightCand) - roomBytes);
 	}
 
-	bool hasChild() const
-	{
-		return mLeftChild != nullptr || mRightChild != nullptr;
-	}
-
-	Leaf* getLeftChild() const
-	{
-		return mLeftChild.get();
-	}
-
-	Leaf* getRightChild() const
-	{
-		return mRightChild.get();
-	}
-
-	void fillData(int width, int height, std::vector<TileType>& data);
-
-private:
 	void getSideRoom(Direction type, OUT std::vector<Room*>& rooms);
 	void getAllRooms(OUT std::vector<Rectangle>& rooms);
-	void getAllHallways(OUT std::vector<Point>& hallways);
 	Point getDoorNextPos(const Point& door, const Room& room);
 
 	bool isConnect(Point begin, Point end,
@@ -243,10 +407,51 @@ private:
 		return isContainPoint(points, { x, y });
 	}
 
+	bool isCancelled(const GenerationControl* control) const
+	{
+		return control != nullptr && control->isCancelled();
+	}
+
+	static MemoryScope* getMemoryScope(const GenerationControl* control)
+	{
+		return control != nullptr ? control->getMemoryScope() : nullptr;
+	}
+
+	static void chargeMemory(const GenerationControl* control, std::int64_t bytes)
+	{
+		if (control != nullptr)
+			control->chargeMemory(bytes);
+	}
+
+	static std::int64_t getRoomHeapBytes(const std::vector<Room*>& rooms)
+	{
+		std::int64_t bytes = 0;
+
+		for (auto room : rooms)
+		{
+			bytes += room->getHeapBytes();
+		}
+
+		return bytes;
+	}
+
+	//connect ӽ  ũ.  Ž visited  ĭ Ͱ  ܰ Ƿ  ð ĺ ۵ 뷫 .
+	static std::int64_t getConnectBytes(const std::vector<Rectangle>& rooms, const std::vector<Point>& hallways,
+		const std::vector<Point>& visited)
+	{
+		const std::size_t frameBytes = 256;
+
+		return static_cast<std::int64_t>(rooms.capacity() * sizeof(Rectangle) + hallways.capacity() * sizeof(Point) +
+			visited.capacity() * (sizeof(Point) + frameBytes));
+	}
+
 	bool isValidHallpos(const Point& pos, Direction side,
 		Rectangle area, const std::vector<Rectangle>& rooms,
 		const std::vector<Point>& otherHall, const std::vector<Point>& visited);
 
+	//pos   ƴѵ      2x2 ̷.
+	bool isWideHallpos(const Point& pos, const std::vector<Point>& hallways);
+
 	//ʺ .   ʺ LEAF_MINIMUM_SIZE   κ   false .
 	template<typename RandomGenerator>
 	bool widthSplit(float splitRange, RandomGenerator& generator)
@@ -287,8 +492,10 @@ private:
 
 	template<typename RandomGenerator>
 	void connect(int complexity, const std::vector<Room*>& leftCand, const std::vector<Room*>& rightCand, 
-		RandomGenerator& generator)
+		RandomGenerator& generator, const GenerationControl* control)
 	{
+		PMG_TRACE_SCOPE("Leaf::connect");
+
 		std::vector<Point> hallways;
 		getAllHallways(hallways);
 
@@ -304,9 +511,15 @@ private:
 		int beginRoomIdx;
 		int endRoomIdx;
 		int prevSize = hallways.size();
+		std::size_t prevCapacity = mHallways.capacity();
+
+		//hallways rooms ڽ Ʈ ü 纻̶ Ʈ Ŭ Ŀ.
+		MemoryCharge scratch(getMemoryScope(control));
+		scratch.set(getConnectBytes(rooms, hallways, visited));
 
 		do
 		{
+			PMG_TRACE_COUNT("bsp.connect.try", 1);
 			hallways.resize(prevSize);
 
 			//leftCand ߿  ϳ  ⸦   .
@@ -334,31 +547,44 @@ private:
 			area = Rectangle(ax, ay, awidth, aheight);
 
 			//   ϰ ٲ㰡鼭  õ.
-		} while (!isConnect(beginHall, endHall, hallways, visited) &&
-			!makeHallway(beginHall, endHall, area, complexity, rooms, visited, hallways, generator));
+			// ٷ  ĭ Ž ʺ ˻縦 ġ Ƿ   2x2 Ǵ  ⼭ ٽ ̴´.
+		} while ((isWideHallpos(beginHall, hallways) || isWideHallpos(endHall, hallways) ||
+			(!isConnect(beginHall, endHall, hallways, visited) &&
+			!makeHallway(beginHall, endHall, area, complexity, rooms, visited, hallways, generator, control, scratch))) &&
+			!isCancelled(control));
 		//̹   ϴ  ϰų,   ̿   Ϳ ϸ .
 
-		leftCand[beginRoomIdx]->mDoors.push_back(beginDoor);
-		rightCand[endRoomIdx]->mDoors.push_back(endDoor);
+		if (isCancelled(control))
+			return;
+
+		leftCand[beginRoomIdx]->addDoor(beginDoor);
+		rightCand[endRoomIdx]->addDoor(endDoor);
+
+		chargeMemory(control, static_cast<std::int64_t>((mHallways.capacity() - prevCapacity) * sizeof(Point)));
 	}
 
-	//dfs    Žϸ  .
+	//dfs    Žϸ  . depth begin ̾  .
 	template<typename RandomGenerator>
 	bool makeHallway(Point begin, Point end, const Rectangle& area, int complexity,
 		const std::vector<Rectangle>& rooms, std::vector<Point>& visited, std::vector<Point>& otherHall,
-		RandomGenerator& generator)
+		RandomGenerator& generator, const GenerationControl* control, MemoryCharge& scratch, int depth = 0)
 	{
+		PMG_TRACE_COUNT("bsp.makeHallway.call", 1);
+
 		Rectangle bound(mInfo.mX + 1, mInfo.mY + 1, mInfo.mWidth - 2, mInfo.mHeight - 2);
-		if (!bound.isContain(begin))
+		if (!bound.isContain(begin) || isCancelled(control))
 		{
 			return false;
 		}
 
 		visited.push_back(begin);
 		otherHall.push_back(begin);
+		scratch.set(getConnectBytes(rooms, otherHall, visited));
 
 		if (begin == end)
 		{
+			PMG_TRACE_HISTOGRAM("bsp.makeHallway.depth", depth);
+			PMG_TRACE_HISTOGRAM("bsp.makeHallway.visited", visited.size());
 			mHallways.push_back(begin);
 			return true;
 		}
@@ -398,7 +624,7 @@ private:
 
 		for (auto& c : cand)
 		{
-			if (makeHallway(c, end, area, complexity, rooms, visited, otherHall, generator))
+			if (makeHallway(c, end, area, complexity, rooms, visited, otherHall, generator, control, scratch, depth + 1))
 			{
 				mHallways.push_back(begin);
 				return true;
@@ -410,96 +636,45 @@ private:
 
 
 	//־ 濡 ϰ    ִ ġ ϳ ȯѴ.
+	//ĺ   ʰ  ĺ    ȣ ĭ ٷ ã´.
 	template<typename RandomGenerator>
 	Point getRandomDoor(const Room& room, bool isBegin, RandomGenerator& generator)
 	{
-		std::vector<Point> cand;
+		Direction sides[3];
 
 		if (mIsWidthSplit)
 		{
-			int ys[2] = { room.mY, room.getBottom() };
-
-			for (int idx = 0; idx < 2; idx++)
-			{
-				int y = ys[idx];
-
-				for (int x = room.mX + 1; x < room.getRight(); x++)
-				{
-					// ޾ 2 پ  ̻.
-					if (isContainPoint(room.mDoors, { x - 1, y }) ||
-						isContainPoint(room.mDoors, { x + 1, y }))
-					{
-						continue;
-					}
-
-					cand.emplace_back(x, y);
-				}
-			}
-
-			int x;
-
-			if (isBegin)
-				x = room.getRight();
-			else
-				x = room.mX;
-
-			for (int y = room.mY + 1; y < room.getBottom(); y++)
-			{
-				// ޾ 2 پ  ̻.
-				if (isContainPoint(room.mDoors, { x, y - 1 }) ||
-					isContainPoint(room.mDoors, { x, y + 1 }))
-				{
-					continue;
-				}
-
-				cand.emplace_back(x, y);
-			}
+			sides[0] = Direction::Top;
+			sides[1] = Direction::Bottom;
+			sides[2] = isBegin ? Direction::Right : Direction::Left;
 		}
-		else // x,y Ḭ̄ ڵ .
+		else // x,y Ī.
 		{
-			int xs[2] = { room.mX, room.getRight() };
-
-			for (int idx = 0; idx < 2; idx++)
-			{
-				int x = xs[idx];
-
-				for (int y = room.mY + 1; y < room.getBottom(); y++)
-				{
-					// ޾ 2 پ  ̻.
-					if (isContainPoint(room.mDoors, { x, y - 1 }) ||
-						isContainPoint(room.mDoors, { x, y + 1 }))
-					{
-						continue;
-					}
-
-					cand.emplace_back(x, y);
-				}
-			}
+			sides[0] = Direction::Left;
+			sides[1] = Direction::Right;
+			sides[2] = isBegin ? Direction::Bottom : Direction::Top;
+		}
 
-			int y;
+		int candNums[3];
+		int candNum = 0;
 
-			if (isBegin)
-				y = room.getBottom();
-			else
-				y = room.mY;
+		for (int i = 0; i < 3; i++)
+		{
+			candNums[i] = room.getDoorCandNum(sides[i]);
+			candNum += candNums[i];
+		}
 
-			for (int x = room.mX + 1; x < room.mX + room.mWidth - 1; x++)
-			{
-				// ޾ 2 پ  ̻.
-				if (isContainPoint(room.mDoors, { x - 1, y }) ||
-					isContainPoint(room.mDoors, { x + 1, y }))
-				{
-					continue;
-				}
+		std::uniform_int_distribution<int> candDist(0, candNum - 1);
+		int idx = candDist(generator);
+		int side = 0;
 
-				cand.emplace_back(x, y);
-			}
+		while (side < 2 && idx >= candNums[side])
+		{
+			idx -= candNums[side];
+			side++;
 		}
 
-		std::uniform_int_distribution<int> candDist(0, cand.size() - 1);
-		Point door = cand[candDist(generator)];
-
-		return door;
+		return room.getDoorCand(sides[side], idx);
 	}
 
 	const int LEAF_MINIMUM_SIZE = 10;
@@ -513,64 +688,82 @@ private:
 	bool mIsWidthSplit;
 };
 
-class BSP
+class BSP : public TileMap
 {
 public:
 	BSP()
-		:mRoot(0, 0, mWidth, mHeight)
+		:TileMap(100, 100), mRoot(0, 0, mWidth, mHeight)
 	{
-		mData.resize(mWidth * mHeight, TileType::Wall);
 	}
 
 	BSP(int width, int height, int splitNum, float splitRange, float sizeMid, float sizeRange, int complexity)
-		: mWidth(width), mHeight(height), 
+		: TileMap(width, height),
 		mSplitNum(splitNum), mSplitRange(splitRange), 
 		mSizeMid(sizeMid), mSizeRange(sizeRange),
 		mComplexity(complexity),
-		mRoot(0, 0, width, height),
-		mData()
+		mRoot(0, 0, width, height)
+	{
+	}
+
+	// ϰ Ʈ Ÿ ۴  .
+	BSP(const BSP& other)
+		: TileMap(other.mWidth, other.mHeight),
+		mSplitNum(other.mSplitNum), mComplexity(other.mComplexity),
+		mSplitRange(other.mSplitRange), mSizeMid(other.mSizeMid), mSizeRange(other.mSizeRange),
+		mRoot(0, 0, other.mWidth, other.mHeight),
+		mIsParallel(other.mIsParallel), mThreadNum(other.mThreadNum),
+		mControl(other.mControl)
 	{
-		mData.resize(width * height, TileType::Wall);
 	}
 
 	template<typename RandomGenerator = std::mt19937>
 	void createMap()
 	{
-		if (mIsCreated)
-		{
-			mRoot.reset(0, 0, mWidth, mHeight);
-		}
-
-		mIsCreated = true;
-
 		std::random_device rd;
-		RandomGenerator generator(rd());
+		createMap<RandomGenerator>(rd());
+	}
+
+	//setControl ѱ ū ҵǸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		return generate<RandomGenerator>(seed, nullptr);
+	}
 
-		split(generator);
-		mRoot.makeRoom(mSizeMid, mSizeRange, generator);
-		mRoot.merge(mComplexity, generator);
-		mRoot.fillData(mWidth, mHeight, mData);
+	//constraint  ϴ  Ȯ ߰ ߰ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed, const MapConstraint& constraint)
+	{
+		return generate<RandomGenerator>(seed, &constraint);
 	}
 
-	TileType getData(int x, int y) const { return mData[x + y*mWidth]; }
+	//õ带 ٲ㰡 constraint ϴ    ִ tryNum õѴ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createValidMap(const MapConstraint& constraint, int tryNum)
+	{
+		std::random_device rd;
 
-	int getWidth() const { return mWidth; }
-	int getHeight() const { return mHeight; }
+		for (int i = 0; i < tryNum; i++)
+		{
+			if (createMap<RandomGenerator>(rd(), constraint))
+				return true;
+		}
+
+		return false;
+	}
 
 	int getComplexity() const { return mComplexity; }
 
 	void setWidth(int width) 
 	{
-		mWidth = width;
+		resize(width, mHeight);
 		mRoot.reset(0, 0, mWidth, mHeight);
-		mData.resize(mWidth*mHeight, TileType::Wall);
 	}
 
 	void setHeight(int height)
 	{
-		mHeight = height;
+		resize(mWidth, height);
 		mRoot.reset(0, 0, mWidth, mHeight);
-		mData.resize(mWidth*mHeight, TileType::Wall);
 	}
 
 	void setSplitNum(int splitNum) { mSplitNum = splitNum; }
@@ -580,38 +773,146 @@ public:
 
 	void setComplexity(int complexity) { mComplexity = complexity; }
 
+	//ڽ Ʈ threadNum  ۾  ķ .    Ʈ ο Ƿ
+	// seed threadNum    ´.   ʹ  ٸ.
+	void setParallel(bool isParallel, int threadNum = static_cast<int>(std::thread::hardware_concurrency()))
+	{
+		mIsParallel = isParallel;
+		mThreadNum = std::max(1, threadNum);
+	}
+
+	// Ž ߿ Ȯϴ  ū ܰ躰  ݹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+	//createMap  ϴ  ؽ.  ؽÿ seed   ´.    .
+	std::uint64_t getParamHash() const
+	{
+		Fnv1a hash;
+
+		hash.addString("BSP");
+		hash.add(mWidth);
+		hash.add(mHeight);
+		hash.add(mSplitNum);
+		hash.add(mSplitRange);
+		hash.add(mSizeMid);
+		hash.add(mSizeRange);
+		hash.add(mComplexity);
+		hash.add(mIsParallel);
+
+		return hash.get();
+	}
+
+	//  Ʈ.   Ÿ   ٷ  .
+	Leaf& getRoot() { return mRoot; }
+
+	// createMap  ޸ ִ밪(Ʈ). Ÿ , Ʈ,  ã  ӽ ۸ .
+	std::int64_t getPeakMemory() const { return mPeakMemory; }
+
+	// createMap setControl ѱ MemoryBudget ѵ Ѿ ߰ .
+	bool isOverMemoryBudget() const { return mIsOverMemoryBudget; }
+
 private:
+	template<typename RandomGenerator>
+	bool generate(unsigned int seed, const MapConstraint* constraint)
+	{
+		PMG_TRACE_SCOPE("BSP::createMap");
+
+		//̹  ޸   control 纻 Ʈ ѱ.
+		MemoryScope memory(mControl.getMemoryBudget());
+		GenerationControl control = mControl;
+
+		control.setMemoryScope(&memory);
+
+		bool isDone = generateTree<RandomGenerator>(seed, constraint, control);
+
+		mPeakMemory = memory.getPeak();
+		mIsOverMemoryBudget = memory.isExceeded();
+		PMG_TRACE_HISTOGRAM("bsp.peakMemory", mPeakMemory);
+
+		return isDone && !mIsOverMemoryBudget;
+	}
 
-	//Ʈ ؼ     Ѵ.
 	template<typename RandomGenerator>
-	void split(RandomGenerator& generator)
+	bool generateTree(unsigned int seed, const MapConstraint* constraint, const GenerationControl& control)
 	{
-		std::queue<Leaf*> leaves;
+		if (!isValid())
+			return false;
 
-		leaves.push(&mRoot);
+		if (mIsCreated)
+		{
+			mRoot.reset(0, 0, mWidth, mHeight);
+			std::fill(mData.begin(), mData.end(), TileType::Wall);
+		}
 
-		for (int i = 0; i < mSplitNum; i++)
+		mIsCreated = true;
+
+		if (!control.chargeMemory(static_cast<std::int64_t>(mData.size() * sizeof(TileType))))
+			return false;
+
+		if (mIsParallel)
 		{
-			int size = leaves.size();
+			//Һ  ڽ Ʈ    ϹǷ constraint  ȮѴ.
+			mRoot.build<RandomGenerator>(mSplitNum, mSplitRange, mSizeMid, mSizeRange, mComplexity,
+				seed, 1, 0, getForkDepth(), &control);
+		}
+		else
+		{
+			RandomGenerator generator(seed);
 
-			for (int s = 0; s < size; s++)
-			{
-				auto top = leaves.front();
-				leaves.pop();
+			mRoot.splitTree(mSplitNum, mSplitRange, generator, &control);
+			control.report(0.1f);
 
-				top->split(mSplitRange, generator);
+			//  ϳ Ƿ  Ŀ     ִ.
+			if (constraint != nullptr && mRoot.getLeafNum() < constraint->mMinRoomNum)
+				return false;
 
-				if (top->getLeftChild() != nullptr)
-					leaves.push(top->getLeftChild());
+			mRoot.makeRoom(mSizeMid, mSizeRange, generator);
+			control.report(0.2f);
 
-				if (top->getRightChild() != nullptr)
-					leaves.push(top->getRightChild());
+			//  ׻   Ƿ    ּ  ɷ  ִ.
+			if (constraint != nullptr &&
+				mRoot.getRoomInnerArea() > constraint->mMaxWalkableRate * mWidth * mHeight)
+			{
+				return false;
 			}
+
+			mRoot.merge(mComplexity, generator, &control);
 		}
+
+		if (control.isCancelled())
+			return false;
+
+		control.report(0.9f);
+
+		mRoot.fillData(mWidth, mHeight, mData.data());
+		control.report(1.0f);
+
+		if (constraint != nullptr)
+		{
+			//computeStats ĭ  Ʈ ǥø .
+			MemoryCharge statsCharge(control.getMemoryScope());
+
+			if (!statsCharge.set(static_cast<std::int64_t>(mData.size() * sizeof(std::uint8_t))))
+				return false;
+
+			return constraint->isSatisfied(computeStats(getView()));
+		}
+
+		return true;
+	}
+
+	//threadNum ̻ ۾  Ʈ .
+	int getForkDepth() const
+	{
+		int depth = 0;
+
+		while ((1 << depth) < mThreadNum)
+			depth++;
+
+		return depth;
 	}
 
-	int mWidth = 100;
-	int mHeight = 100;
 	int mSplitNum = 6;
 	int mComplexity = 1;
 	float mSplitRange = 0.2f;
@@ -619,7 +920,11 @@ private:
 	float mSizeRange = 0.2f;
 	Leaf mRoot;
 	bool mIsCreated = false;
-	std::vector<TileType> mData;
+	bool mIsParallel = false;
+	int mThreadNum = 1;
+	GenerationControl mControl;
+	std::int64_t mPeakMemory = 0;
+	bool mIsOverMemoryBudget = false;
 };
 
 }
\ No newline at end of file
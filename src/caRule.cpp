@@ -0,0 +1,76 @@
+#include "caRule.h"
+
+pmg::RuleStep pmg::getThresholdStep(int wallCriterionNum)
+{
+	typedef Moore<1> M;
+
+	switch (std::max(0, std::min(wallCriterionNum, 10)))
+	{
+	case 0: return makeRuleStep<M, ThresholdRule<0>>();
+	case 1: return makeRuleStep<M, ThresholdRule<1>>();
+	case 2: return makeRuleStep<M, ThresholdRule<2>>();
+	case 3: return makeRuleStep<M, ThresholdRule<3>>();
+	case 4: return makeRuleStep<M, ThresholdRule<4>>();
+	case 5: return makeRuleStep<M, ThresholdRule<5>>();
+	case 6: return makeRuleStep<M, ThresholdRule<6>>();
+	case 7: return makeRuleStep<M, ThresholdRule<7>>();
+	case 8: return makeRuleStep<M, ThresholdRule<8>>();
+	case 9: return makeRuleStep<M, ThresholdRule<9>>();
+	default: return makeRuleStep<M, ThresholdRule<10>>();
+	}
+}
+
+pmg::RuleStep pmg::getThresholdTableStep(int wallCriterionNum)
+{
+	typedef Moore<1> M;
+
+	switch (std::max(0, std::min(wallCriterionNum, 10)))
+	{
+	case 0: return makeTableRuleStep<M, ThresholdRule<0>>();
+	case 1: return makeTableRuleStep<M, ThresholdRule<1>>();
+	case 2: return makeTableRuleStep<M, ThresholdRule<2>>();
+	case 3: return makeTableRuleStep<M, ThresholdRule<3>>();
+	case 4: return makeTableRuleStep<M, ThresholdRule<4>>();
+	case 5: return makeTableRuleStep<M, ThresholdRule<5>>();
+	case 6: return makeTableRuleStep<M, ThresholdRule<6>>();
+	case 7: return makeTableRuleStep<M, ThresholdRule<7>>();
+	case 8: return makeTableRuleStep<M, ThresholdRule<8>>();
+	case 9: return makeTableRuleStep<M, ThresholdRule<9>>();
+	default: return makeTableRuleStep<M, ThresholdRule<10>>();
+	}
+}
+
+int pmg::getMaxRadius(const RuleSchedule& schedule)
+{
+	int radius = 0;
+
+	for (auto& phase : schedule)
+	{
+		radius = std::max(radius, phase.mStep.mRadius);
+	}
+
+	return radius;
+}
+
+pmg::RuleSchedule pmg::CaveRule::fourFive(int iteration)
+{
+	return { RulePhase(makeRuleStep<Moore<1>, ThresholdRule<5>>(), iteration) };
+}
+
+pmg::RuleSchedule pmg::CaveRule::openCave()
+{
+	return
+	{
+		RulePhase(makeRuleStep<Moore<2>, ThresholdRule<13>>(), 2),
+		RulePhase(makeRuleStep<Moore<1>, ThresholdRule<5>>(), 3)
+	};
+}
+
+pmg::RuleSchedule pmg::CaveRule::smoothCave()
+{
+	return
+	{
+		RulePhase(makeRuleStep<Moore<1>, ThresholdRule<5>>(), 4),
+		RulePhase(makeRuleStep<VonNeumann<1>, ThresholdRule<3>>(), 1)
+	};
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "types.h"
+
+namespace pmg
+{
+
+//߽ɿ Radius Ÿ  簢 ̿. IncludeCenter false ڱ ڽ  ʴ´.
+template<int Radius, bool IncludeCenter = true>
+struct Moore
+{
+	static const int RADIUS = Radius;
+
+	//ؽÿ  ĺ. , ݰ, ߽  η .
+	static constexpr std::uint64_t getId()
+	{
+		return 1u << 16 | Radius << 1 | (IncludeCenter ? 1 : 0);
+	}
+
+	static constexpr bool contains(int dx, int dy)
+	{
+		return IncludeCenter || dx != 0 || dy != 0;
+	}
+};
+
+//߽ɿ ư Ÿ Radius   ̿.
+template<int Radius, bool IncludeCenter = true>
+struct VonNeumann
+{
+	static const int RADIUS = Radius;
+
+	static constexpr std::uint64_t getId()
+	{
+		return 2u << 16 | Radius << 1 | (IncludeCenter ? 1 : 0);
+	}
+
+	static constexpr bool contains(int dx, int dy)
+	{
+		return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy) <= Radius &&
+			(IncludeCenter || dx != 0 || dy != 0);
+	}
+};
+
+//̿   Criterion ̸̻ . CellularAutomata ⺻ Ģ.
+template<int Criterion>
+struct ThresholdRule
+{
+	//ؽÿ  ĺ. Ģ  ذ .
+	static constexpr std::uint64_t getId()
+	{
+		return 1ull << 56 | static_cast<std::uint32_t>(Criterion);
+	}
+
+	static bool isWall(bool, int count)
+	{
+		return count >= Criterion;
+	}
+};
+
+//B/S Ģ. Birth, Survive   Ʈũ.
+// ĭ Birth شϴ  ,  Survive شϴ    ȴ.
+template<unsigned Birth, unsigned Survive>
+struct BirthSurviveRule
+{
+	static constexpr std::uint64_t getId()
+	{
+		return 2ull << 56 | static_cast<std::uint64_t>(Birth) << 28 | Survive;
+	}
+
+	static bool isWall(bool wall, int count)
+	{
+		return wall ? ((Survive >> count) & 1u) != 0 : ((Birth >> count) & 1u) != 0;
+	}
+};
+
+//  ĭ ̿  .  ˻  ٷ .
+template<typename Neighbourhood>
+int countInnerWall(const TileType* center, int width)
+{
+	const int R = Neighbourhood::RADIUS;
+	int res = 0;
+
+	for (int dy = -R; dy <= R; dy++)
+	{
+		const TileType* row = center + static_cast<std::ptrdiff_t>(dy) * width;
+
+		for (int dx = -R; dx <= R; dx++)
+		{
+			if (Neighbourhood::contains(dx, dy))
+				res += row[dx] == TileType::Wall;
+		}
+	}
+
+	return res;
+}
+
+//  ó ĭ ̿  . ȭ   ִ  .
+template<typename Neighbourhood>
+int countBorderWall(const TileType* src, int width, int height, int x, int y)
+{
+	const int R = Neighbourhood::RADIUS;
+	int res = 0;
+
+	for (int dy = -R; dy <= R; dy++)
+	{
+		for (int dx = -R; dx <= R; dx++)
+		{
+			if (!Neighbourhood::contains(dx, dy))
+				continue;
+
+			int ax = x + dx;
+			int ay = y + dy;
+
+			if (ax < 0 || ax >= width || ay < 0 || ay >= height ||
+				src[toIndex(ax, ay, width)] == TileType::Wall)
+			{
+				res++;
+			}
+		}
+	}
+
+	return res;
+}
+
+//src Ģ      area  ĭ dst . area  dst ǵ帮 ʴ´.
+// ĭ  ĭ  иؼ  б  .
+template<typename Neighbourhood, typename Rule>
+void applyRule(const TileType* src, TileType* dst, int width, int height, const Rectangle& area)
+{
+	const int R = Neighbourhood::RADIUS;
+	int areaLeft = std::max(0, area.mX);
+	int areaRight = std::min(width, area.mX + area.mWidth);
+	int left = std::min(std::max(R, areaLeft), areaRight);
+	int right = std::max(left, std::min(width - R, areaRight));
+
+	for (int y = std::max(0, area.mY); y < std::min(height, area.mY + area.mHeight); y++)
+	{
+		const TileType* srcRow = src + toIndex(0, y, width);
+		TileType* dstRow = dst + toIndex(0, y, width);
+
+		if (y < R || y >= height - R)
+		{
+			for (int x = areaLeft; x < areaRight; x++)
+			{
+				int count = countBorderWall<Neighbourhood>(src, width, height, x, y);
+				dstRow[x] = Rule::isWall(srcRow[x] == TileType::Wall, count) ? TileType::Wall : TileType::Room;
+			}
+
+			continue;
+		}
+
+		for (int x = areaLeft; x < left; x++)
+		{
+			int count = countBorderWall<Neighbourhood>(src, width, height, x, y);
+			dstRow[x] = Rule::isWall(srcRow[x] == TileType::Wall, count) ? TileType::Wall : TileType::Room;
+		}
+
+		for (int x = left; x < right; x++)
+		{
+			int count = countInnerWall<Neighbourhood>(srcRow + x, width);
+			dstRow[x] = Rule::isWall(srcRow[x] == TileType::Wall, count) ? TileType::Wall : TileType::Room;
+		}
+
+		for (int x = right; x < areaRight; x++)
+		{
+			int count = countBorderWall<Neighbourhood>(src, width, height, x, y);
+			dstRow[x] = Rule::isWall(srcRow[x] == TileType::Wall, count) ? TileType::Wall : TileType::Room;
+		}
+	}
+}
+
+typedef void(*RuleFunc)(const TileType* src, TileType* dst, int width, int height, const Rectangle& area);
+
+// Ÿӿ Ưȭ Ģ  ܰ. area  ĭ Ѵ.
+//mNeighbourhoodId, mRuleId ̿ Ģ getId() μ ٲ  ǥ   .
+//  ̿ Ģ getId() ؾ Ѵ. mRadius  ĭ   д   Ÿ.
+struct RuleStep
+{
+	RuleStep() : mFunc(nullptr), mNeighbourhoodId(0), mRuleId(0), mRadius(0) { }
+	RuleStep(RuleFunc func, std::uint64_t neighbourhoodId, std::uint64_t ruleId, int radius)
+		: mFunc(func), mNeighbourhoodId(neighbourhoodId), mRuleId(ruleId), mRadius(radius) { }
+
+	void operator()(const TileType* src, TileType* dst, int width, int height, const Rectangle& area) const
+	{
+		mFunc(src, dst, width, height, area);
+	}
+
+	RuleFunc mFunc;
+	std::uint64_t mNeighbourhoodId;
+	std::uint64_t mRuleId;
+	int mRadius;
+};
+
+template<typename Neighbourhood, typename Rule>
+RuleStep makeRuleStep()
+{
+	return RuleStep(&applyRule<Neighbourhood, Rule>, Neighbourhood::getId(), Rule::getId(), Neighbourhood::RADIUS);
+}
+
+//4x4 ĭ  Ʈ  2x2 ĭ  ·  ǥ. ݰ 1 ̸̿  Ģ̵   ִ.
+//ε (row * 4 + col) Ʈ (x - 1 + col, y - 1 + row) ĭ,  (oy * 2 + ox) Ʈ (x + ox, y + oy) ĭ.
+template<typename Neighbourhood, typename Rule>
+const std::vector<std::uint8_t>& getRuleTable()
+{
+	static_assert(Neighbourhood::RADIUS == 1, "rule table needs a radius 1 neighbourhood");
+
+	static const std::vector<std::uint8_t> table = []()
+	{
+		std::vector<std::uint8_t> res(1 << 16);
+
+		for (int idx = 0; idx < (1 << 16); idx++)
+		{
+			std::uint8_t next = 0;
+
+			for (int oy = 0; oy < 2; oy++)
+			{
+				for (int ox = 0; ox < 2; ox++)
+				{
+					int count = 0;
+
+					for (int dy = -1; dy <= 1; dy++)
+					{
+						for (int dx = -1; dx <= 1; dx++)
+						{
+							if (Neighbourhood::contains(dx, dy))
+								count += (idx >> ((oy + 1 + dy) * 4 + ox + 1 + dx)) & 1;
+						}
+					}
+
+					bool isWall = ((idx >> ((oy + 1) * 4 + ox + 1)) & 1) != 0;
+
+					if (Rule::isWall(isWall, count))
+						next |= 1 << (oy * 2 + ox);
+				}
+			}
+
+			res[idx] = next;
+		}
+
+		return res;
+	}();
+
+	return table;
+}
+
+//applyRule   ǥ  Ģ. ̸ 1 Ʈ ڷ ű 
+//2x2 ĭ 4x4 ̿ 16Ʈ  ǥ   4ĭ Ѳ Ѵ.
+template<typename Neighbourhood, typename Rule>
+void applyTableRule(const TileType* src, TileType* dst, int width, int height, const Rectangle& area)
+{
+	const std::vector<std::uint8_t>& table = getRuleTable<Neighbourhood, Rule>();
+
+	int left = std::max(0, area.mX);
+	int top = std::max(0, area.mY);
+	int right = std::min(width, area.mX + area.mWidth);
+	int bottom = std::min(height, area.mY + area.mHeight);
+
+	if (left >= right || top >= bottom)
+		return;
+
+	int blockWidth = (right - left + 1) / 2;
+	int blockHeight = (bottom - top + 1) / 2;
+
+	//ڴ area ٱ  ĭ, ึ 2x2   4ĭ â 4Ʈ ´.   .
+	//  ϳ  4ุ а    2 ġǷ 4¥  ۿ ʷ ä.
+	int packedWidth = blockWidth * 2 + 2;
+	thread_local std::vector<std::uint8_t> packed;
+	thread_local std::vector<std::uint8_t> windows;
+
+	packed.resize(packedWidth);
+	windows.resize(static_cast<std::size_t>(blockWidth) * 4);
+
+	auto packRow = [&](int r)
+	{
+		int y = top - 1 + r;
+
+		for (int i = 0; i < packedWidth; i++)
+		{
+			int x = left - 1 + i;
+
+			packed[i] = x < 0 || x >= width || y < 0 || y >= height || src[toIndex(x, y, width)] == TileType::Wall;
+		}
+
+		std::uint8_t* window = &windows[static_cast<std::size_t>(r & 3) * blockWidth];
+
+		for (int b = 0; b < blockWidth; b++)
+		{
+			const std::uint8_t* cell = &packed[b * 2];
+
+			window[b] = static_cast<std::uint8_t>(cell[0] | cell[1] << 1 | cell[2] << 2 | cell[3] << 3);
+		}
+	};
+
+	packRow(0);
+	packRow(1);
+
+	for (int by = 0; by < blockHeight; by++)
+	{
+		packRow(by * 2 + 2);
+		packRow(by * 2 + 3);
+
+		const std::uint8_t* row0 = &windows[static_cast<std::size_t>((by * 2) & 3) * blockWidth];
+		const std::uint8_t* row1 = &windows[static_cast<std::size_t>((by * 2 + 1) & 3) * blockWidth];
+		const std::uint8_t* row2 = &windows[static_cast<std::size_t>((by * 2 + 2) & 3) * blockWidth];
+		const std::uint8_t* row3 = &windows[static_cast<std::size_t>((by * 2 + 3) & 3) * blockWidth];
+		int y = top + by * 2;
+
+		for (int b = 0; b < blockWidth; b++)
+		{
+			std::uint8_t next = table[row0[b] | row1[b] << 4 | row2[b] << 8 | row3[b] << 12];
+			int x = left + b * 2;
+
+			//area ũⰡ Ȧ   ٱ ĭ  ʴ´.
+			dst[toIndex(x, y, width)] = (next & 1) ? TileType::Wall : TileType::Room;
+
+			if (x + 1 < right)
+				dst[toIndex(x + 1, y, width)] = (next & 2) ? TileType::Wall : TileType::Room;
+
+			if (y + 1 < bottom)
+			{
+				dst[toIndex(x, y + 1, width)] = (next & 4) ? TileType::Wall : TileType::Room;
+
+				if (x + 1 < right)
+					dst[toIndex(x + 1, y + 1, width)] = (next & 8) ? TileType::Wall : TileType::Room;
+			}
+		}
+	}
+}
+
+template<typename Neighbourhood, typename Rule>
+RuleStep makeTableRuleStep()
+{
+	return RuleStep(&applyTableRule<Neighbourhood, Rule>, Neighbourhood::getId(), Rule::getId(), Neighbourhood::RADIUS);
+}
+
+//Ģ step iteration  ݺ.
+struct RulePhase
+{
+	RulePhase() : mIteration(0) { }
+	RulePhase(RuleStep step, int iteration) : mStep(step), mIteration(iteration) { }
+
+	RuleStep mStep;
+	int mIteration;
+};
+
+//ݺ ٲ  Ģ . տ  Ѵ.
+typedef std::vector<RulePhase> RuleSchedule;
+
+//schedule Ģ д   ̿ Ÿ.   0.
+int getMaxRadius(const RuleSchedule& schedule);
+
+// 3x3(߽ ) ̿  ThresholdRule Ÿ ذ ش.
+RuleStep getThresholdStep(int wallCriterionNum);
+
+//getThresholdStep   ǥ  .
+RuleStep getThresholdTableStep(int wallCriterionNum);
+
+//   Ģ.
+namespace CaveRule
+{
+	//9ĭ  5ĭ ̻ ̸ .    4-5 Ģ.
+	RuleSchedule fourFive(int iteration = 5);
+
+	//5x5 ټ ū     4-5 Ģ ٵ´. а ձ .
+	RuleSchedule openCave();
+
+	//4-5 Ģ   ̸ ټ 밢 ⸦ Ѵ. Ų .
+	RuleSchedule smoothCave();
+}
+
+}
\ No newline at end of file
@@ -1,36 +1,228 @@
 #include "cellularAutomata.h"
 
-int pmg::CellularAutomata::getAdjustWallNum(int x, int y)
+bool pmg::CellularAutomata::runSchedule(const RuleSchedule& schedule, TileBuffer& data, int width, int height,
+	const MapConstraint* constraint)
 {
-	Point adjs[9] =
-	{
-		{ x, y },
-		{ x + 1, y },
-		{ x + 1, y + 1 },
-		{ x, y + 1 },
-		{ x - 1, y + 1 },
-		{ x - 1, y },
-		{ x - 1, y - 1 },
-		{ x, y - 1 },
-		{ x + 1,y - 1 }
-	};
-
-	int res = 0;
-
-	for (int i = 0; i < 9; i++)
+	if (mIsActiveTracking)
+		return runActive(schedule, data, width, height, Rectangle(0, 0, width, height), constraint);
+
+	PMG_TRACE_SCOPE("CellularAutomata::runSchedule");
+
+	mNextData.resize(static_cast<std::size_t>(width) * height, TileType::Wall);
+
+	//  ͸ ٲ۴. TileBuffer swapϸ Ҵڵ  ٲ
+	//data setMappedStorage ű ۿٸ   ۷ Ѿ .
+	std::size_t size = data.size();
+	TileType* now = data.data();
+	TileType* next = mNextData.data();
+	bool isFirst = true;
+
+	for (auto& phase : schedule)
 	{
-		const Point& adj = adjs[i];
+		for (int i = 0; i < phase.mIteration; i++)
+		{
+			if (mControl.isCancelled())
+				return false;
+
+			phase.mStep(now, next, width, height, Rectangle(0, 0, width, height));
+
+			std::swap(now, next);
+
+			mStepNum++;
+			mControl.report(static_cast<float>(mStepNum) / mStepTotal);
+
+			//ù ݺ ʱ   ũ ٲǷ ǳʶڴ.
+			if (constraint != nullptr && mIsEarlyReject && !isFirst)
+			{
+				std::size_t walkable = size - std::count(now, now + size, TileType::Wall);
+				float rate = static_cast<float>(walkable) / size;
+
+				if (rate < constraint->mMinWalkableRate - mEarlyRejectMargin ||
+					rate > constraint->mMaxWalkableRate + mEarlyRejectMargin)
+				{
+					PMG_TRACE_EVENT("ca.earlyReject");
+					return false;
+				}
+			}
+
+			isFirst = false;
+		}
+	}
+
+	if (now != data.data())
+		std::copy(now, now + size, data.data());
+
+	return true;
+}
 
-		//ȭ ̸  ִ  
-		if (adj.mX < 0 || adj.mX >= mWidth || adj.mY < 0 || adj.mY >= mHeight)
+void pmg::CellularAutomata::restoreOutside(const TileBuffer& data, int width,
+	const Rectangle& copy, const Rectangle& area)
+{
+	for (int y = 0; y < copy.mHeight; y++)
+	{
+		for (int x = 0; x < copy.mWidth; x++)
 		{
-			res++;
+			Point pos(copy.mX + x, copy.mY + y);
+
+			if (!area.isContain(pos))
+			{
+				mLevelData[toIndex(x, y, copy.mWidth)] = data[toIndex(pos.mX, pos.mY, width)];
+			}
 		}
-		else if (mData[adj.mX + adj.mY * mWidth] == TileType::Wall)
+	}
+}
+
+bool pmg::CellularAutomata::runActive(const RuleSchedule& schedule, TileBuffer& data, int width, int height,
+	const Rectangle& area, const MapConstraint* constraint)
+{
+	PMG_TRACE_SCOPE("CellularAutomata::runActive");
+
+	mNextData.resize(static_cast<std::size_t>(width) * height, TileType::Wall);
+
+	// 迡 ٲ ĭ ̿  ʸӱ   ʵ  Ģ ݰ ̻ ´.
+	int blockSize = std::max(mBlockSize, getMaxRadius(schedule));
+
+	int blockWidth = (area.mWidth + blockSize - 1) / blockSize;
+	int blockHeight = (area.mHeight + blockSize - 1) / blockSize;
+
+	mActive.resize(blockWidth * blockHeight);
+	mNextActive.resize(blockWidth * blockHeight);
+
+	//  ִ ĭ  ٲ ĭŭ Ѵ.
+	std::size_t size = data.size();
+	std::int64_t walkable = static_cast<std::int64_t>(size - std::count(data.begin(), data.end(), TileType::Wall));
+	bool isFirst = true;
+
+	for (auto& phase : schedule)
+	{
+		//Ģ ٲ  ĭ ٽ ٲ  Ƿ  .
+		std::fill(mActive.begin(), mActive.end(), 1);
+
+		for (int i = 0; i < phase.mIteration; i++)
 		{
-			res++;
+			if (mControl.isCancelled())
+				return false;
+
+			for (int b = 0; b < blockWidth * blockHeight; b++)
+			{
+				if (!mActive[b])
+					continue;
+
+				Rectangle block(area.mX + (b % blockWidth) * blockSize, area.mY + (b / blockWidth) * blockSize,
+					std::min(blockSize, area.mWidth - (b % blockWidth) * blockSize),
+					std::min(blockSize, area.mHeight - (b / blockWidth) * blockSize));
+
+				phase.mStep(data.data(), mNextData.data(), width, height, block);
+				PMG_TRACE_COUNT("ca.activeBlock", 1);
+			}
+
+			//    ݿؾ ̿    д´.
+			bool isChanged = false;
+			std::fill(mNextActive.begin(), mNextActive.end(), 0);
+
+			for (int b = 0; b < blockWidth * blockHeight; b++)
+			{
+				if (!mActive[b])
+					continue;
+
+				int bx = b % blockWidth;
+				int by = b / blockWidth;
+				int left = area.mX + bx * blockSize;
+				int top = area.mY + by * blockSize;
+				int right = std::min(left + blockSize, area.mX + area.mWidth);
+				int bottom = std::min(top + blockSize, area.mY + area.mHeight);
+				bool isBlockChanged = false;
+
+				for (int y = top; y < bottom; y++)
+				{
+					TileType* nowRow = data.data() + toIndex(0, y, width);
+					const TileType* nextRow = mNextData.data() + toIndex(0, y, width);
+
+					if (std::equal(nowRow + left, nowRow + right, nextRow + left))
+						continue;
+
+					for (int x = left; x < right; x++)
+					{
+						TileType& now = data[toIndex(x, y, width)];
+						TileType next = mNextData[toIndex(x, y, width)];
+
+						if (now == next)
+							continue;
+
+						walkable += now == TileType::Wall ? 1 : -1;
+						now = next;
+						isBlockChanged = true;
+					}
+				}
+
+				if (!isBlockChanged)
+					continue;
+
+				isChanged = true;
+
+				for (int ny = std::max(0, by - 1); ny <= std::min(blockHeight - 1, by + 1); ny++)
+				{
+					for (int nx = std::max(0, bx - 1); nx <= std::min(blockWidth - 1, bx + 1); nx++)
+					{
+						mNextActive[nx + ny * blockWidth] = 1;
+					}
+				}
+			}
+
+			std::swap(mActive, mNextActive);
+
+			mStepNum++;
+			mControl.report(static_cast<float>(mStepNum) / mStepTotal);
+
+			if (constraint != nullptr && mIsEarlyReject && !isFirst)
+			{
+				float rate = static_cast<float>(walkable) / size;
+
+				if (rate < constraint->mMinWalkableRate - mEarlyRejectMargin ||
+					rate > constraint->mMaxWalkableRate + mEarlyRejectMargin)
+				{
+					PMG_TRACE_EVENT("ca.earlyReject");
+					return false;
+				}
+			}
+
+			isFirst = false;
+
+			//  Ģ  ݺ  Ƿ ǳʶڴ.
+			if (!isChanged)
+			{
+				PMG_TRACE_HISTOGRAM("ca.convergeIteration", i);
+				mStepNum += phase.mIteration - i - 1;
+				break;
+			}
 		}
 	}
 
-	return res;
+	return true;
+}
+
+void pmg::CellularAutomata::smooth(const Rectangle& area, int iteration)
+{
+	smooth(area, { RulePhase(getThresholdStep(mWallCriterionNum), iteration) });
+}
+
+void pmg::CellularAutomata::smooth(const Rectangle& area, const RuleSchedule& schedule)
+{
+	int left = std::max(0, area.mX);
+	int top = std::max(0, area.mY);
+	int right = std::min(mWidth, area.mX + area.mWidth);
+	int bottom = std::min(mHeight, area.mY + area.mHeight);
+
+	if (left >= right || top >= bottom)
+		return;
+
+	mStepNum = 0;
+	mStepTotal = 0;
+
+	for (auto& phase : schedule)
+	{
+		mStepTotal += phase.mIteration;
+	}
+
+	runActive(schedule, mData, mWidth, mHeight, Rectangle(left, top, right - left, bottom - top), nullptr);
 }
@@ -1,84 +1,372 @@
 #pragma once
 #include <random>
+#include <type_traits>
 #include "types.h"
+#include "caRule.h"
+#include "random.h"
+#include "validator.h"
+#include "control.h"
+#include "mapView.h"
+#include "trace.h"
+#include "hash.h"
 
 namespace pmg
 {
 
-class CellularAutomata
+class CellularAutomata : public TileMap
 {
 public:
 	CellularAutomata(int width, int height, int iteration, float initialWallRate, int wallCriterionNum)
-		:mWidth(width), mHeight(height), 
+		:TileMap(width, height),
 		mIterationNum(iteration), mInitialWallRate(initialWallRate), mWallCriterionNum(wallCriterionNum)
 	{
-		mData.resize(mWidth * mHeight, TileType::Wall);
 	}
 
 	template<typename RandomGenerator = std::mt19937>
 	void createMap()
 	{
 		std::random_device rd;
-		RandomGenerator generator(rd());
+		createMap<RandomGenerator>(rd());
+	}
+
+	//setControl ѱ ū ҵǸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		return generate<RandomGenerator>(seed, nullptr);
+	}
+
+	//ݺ    ִ  constraint ũ  ٷ ߰ false ȯ.
+	//߰    ϴ ޸ƽ̶    seed   ִ.
+	//Ȯ  ʿϸ setEarlyReject(false) .
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed, const MapConstraint& constraint)
+	{
+		return generate<RandomGenerator>(seed, &constraint);
+	}
+
+	//õ带 ٲ㰡 constraint ϴ    ִ tryNum õѴ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createValidMap(const MapConstraint& constraint, int tryNum)
+	{
+		std::random_device rd;
+
+		for (int i = 0; i < tryNum; i++)
+		{
+			if (createMap<RandomGenerator>(rd(), constraint))
+				return true;
+		}
+
+		return false;
+	}
+
+	//   mIterationNum, mWallCriterionNum   Ģ   Ѵ.
+	void setRuleSchedule(const RuleSchedule& schedule) { mSchedule = schedule; }
+
+	//levelNum ܰ  ģ ػ󵵺 Ѵ. 1̸  ػ󵵿 .
+	//levelIteration ػ󵵸 ø   ܰ迡 ٵ Ƚ, jitterRate  ĭ  Ȯ.
+	void setLevel(int levelNum, int levelIteration, float jitterRate)
+	{
+		mLevelNum = levelNum;
+		mLevelIteration = levelIteration;
+		mJitterRate = jitterRate;
+	}
+
+	//̹  data area ʸ  ä  Ģ Ѵ. area  б⸸ Ѵ.
+	//ռ ο   ü Ÿ ۴  ʴ´.
+	template<typename RandomGenerator>
+	void fillArea(TileBuffer& data, int width, int height, const Rectangle& area, RandomGenerator& generator)
+	{
+		//Ģ ݰ游ŭ ٱ  ؼ area  ̿  ʿ е Ѵ.
+		int left = std::max(0, area.mX - AREA_MARGIN);
+		int top = std::max(0, area.mY - AREA_MARGIN);
+		int right = std::min(width - 1, area.getRight() + AREA_MARGIN);
+		int bottom = std::min(height - 1, area.getBottom() + AREA_MARGIN);
+		Rectangle copy(left, top, right - left + 1, bottom - top + 1);
+
+		if (copy.mWidth <= 0 || copy.mHeight <= 0)
+			return;
+
+		mLevelData.resize(static_cast<std::size_t>(copy.mWidth) * copy.mHeight);
+		fillRandom(mLevelData, copy.mWidth, copy.mHeight, generator);
+		restoreOutside(data, width, copy, area);
+
+		mNextData.resize(static_cast<std::size_t>(copy.mWidth) * copy.mHeight);
+
+		for (auto& phase : getSchedule())
+		{
+			for (int i = 0; i < phase.mIteration; i++)
+			{
+				phase.mStep(mLevelData.data(), mNextData.data(), copy.mWidth, copy.mHeight,
+					Rectangle(0, 0, copy.mWidth, copy.mHeight));
+
+				std::swap(mLevelData, mNextData);
+				restoreOutside(data, width, copy, area);
+			}
+		}
+
+		for (int y = std::max(area.mY, top); y <= std::min(area.getBottom(), bottom); y++)
+		{
+			for (int x = std::max(area.mX, left); x <= std::min(area.getRight(), right); x++)
+			{
+				data[toIndex(x, y, width)] = mLevelData[toIndex(x - left, y - top, copy.mWidth)];
+			}
+		}
+	}
+
+	//true  ݺ ٲ blockSize ũ ϰ  ̿ ϸ ٽ ϰ, ٲ ĭ   ݺ ǳʶڴ.
+	//      þ.
+	//ٲ ĭ ̿ ϱ Ƿ  Ģ ݰ溸   ,    ִ ݰ ø.
+	void setActiveTracking(bool isActiveTracking, int blockSize = 16)
+	{
+		mIsActiveTracking = isActiveTracking;
+		mBlockSize = std::max(1, blockSize);
+	}
+
+	//̹  ʿ area ʸ Ģ iteration ٽ Ѵ. ٲ ϸ 󰡸 ȭ   .
+	void smooth(const Rectangle& area, int iteration);
+	void smooth(const Rectangle& area, const RuleSchedule& schedule);
+
+	//createMap(seed, constraint) ݺ    ִ  constraint  margin    Ѵ.
+	//false    constraintθ ǴѴ.   Ƿ ؽÿ  ʴ´.
+	void setEarlyReject(bool isEarlyReject, float margin = 0.05f)
+	{
+		mIsEarlyReject = isEarlyReject;
+		mEarlyRejectMargin = std::max(0.0f, margin);
+	}
+
+	//createMap  ϴ  ؽ. Ȱ    ٲ Ƿ  ʴ´.
+	// ѱ Ģ  ̿ Ģ ĺڷ ϹǷ μ ٲ .
+	std::uint64_t getParamHash() const
+	{
+		Fnv1a hash;
+
+		hash.addString("CellularAutomata");
+		hash.add(mWidth);
+		hash.add(mHeight);
+		hash.add(mInitialWallRate);
+		hash.add(mLevelNum);
+		hash.add(mLevelIteration);
+		hash.add(mJitterRate);
+
+		if (mSchedule.empty())
+		{
+			hash.add(mIterationNum);
+			hash.add(mWallCriterionNum);
+		}
+
+		for (auto& phase : mSchedule)
+		{
+			hash.add(phase.mStep.mNeighbourhoodId);
+			hash.add(phase.mStep.mRuleId);
+			hash.add(phase.mIteration);
+		}
+
+		return hash.get();
+	}
+
+	// ݺ Ȯϴ  ū ݺ   ݹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+private:
+	template<typename RandomGenerator>
+	bool generate(unsigned int seed, const MapConstraint* constraint)
+	{
+		if (!isValid())
+			return false;
+
+		RandomGenerator generator(seed);
+
+		RuleSchedule schedule = getSchedule();
 
+		mStepNum = 0;
+		mStepTotal = 0;
+
+		for (auto& phase : schedule)
+		{
+			mStepTotal += phase.mIteration;
+		}
+
+		if (mLevelNum > 1)
+		{
+			mStepTotal += (mLevelNum - 1) * mLevelIteration;
+		}
+
+		if (mLevelNum <= 1)
+		{
+			fillRandom(mData, mWidth, mHeight, generator);
+
+			return runSchedule(schedule, mData, mWidth, mHeight, constraint) &&
+				isSatisfied(constraint);
+		}
+
+		// ģ ܰ迡 ü Ģ  ū  ´.
+		int shift = mLevelNum - 1;
+		int width = ((mWidth - 1) >> shift) + 1;
+		int height = ((mHeight - 1) >> shift) + 1;
+
+		TileBuffer coarse(static_cast<std::size_t>(width) * height);
+
+		fillRandom(coarse, width, height, generator);
+
+		if (!runSchedule(schedule, coarse, width, height, constraint))
+			return false;
+
+		// ܰ辿 ػ󵵸   ø鼭 踸 ݾ     ٵ´.
+		RuleSchedule smooth = { RulePhase(getThresholdTableStep(mWallCriterionNum), mLevelIteration) };
+
+		for (int level = shift - 1; level >= 0; level--)
+		{
+			int fineWidth = ((mWidth - 1) >> level) + 1;
+			int fineHeight = ((mHeight - 1) >> level) + 1;
+
+			TileBuffer& fine = level == 0 ? mData : mLevelData;
+			fine.resize(static_cast<std::size_t>(fineWidth) * fineHeight);
+
+			upsample(coarse, width, height, fine, fineWidth, fineHeight, generator);
+
+			if (!runSchedule(smooth, fine, fineWidth, fineHeight, constraint))
+				return false;
+
+			width = fineWidth;
+			height = fineHeight;
+
+			if (level != 0)
+			{
+				std::swap(coarse, mLevelData);
+			}
+		}
+
+		return isSatisfied(constraint);
+	}
+
+	template<typename RandomGenerator>
+	void fillRandom(TileBuffer& data, int width, int height, RandomGenerator& generator)
+	{
+		fillRandom(data, width, height, generator,
+			std::integral_constant<bool, RandomTraits<RandomGenerator>::IS_BULK>());
+	}
+
+	//   64Ʈ ũ 64ĭ Ѳ ä.
+	template<typename RandomGenerator>
+	void fillRandom(TileBuffer& data, int width, int height, RandomGenerator& generator, std::true_type)
+	{
+		int probability = static_cast<int>(mInitialWallRate * 256.0f + 0.5f);
+		std::size_t size = static_cast<std::size_t>(width) * height;
+
+		for (std::size_t i = 0; i < size; i += 64)
+		{
+			std::uint64_t mask = generator.nextMask(probability);
+			int num = static_cast<int>(std::min<std::size_t>(64, size - i));
+
+			for (int b = 0; b < num; b++)
+			{
+				data[i + b] = ((mask >> b) & 1) ? TileType::Wall : TileType::Room;
+			}
+		}
+	}
+
+	template<typename RandomGenerator>
+	void fillRandom(TileBuffer& data, int width, int height, RandomGenerator& generator, std::false_type)
+	{
 		std::uniform_real_distribution<float> probDist(0.0f, 1.0f);
 
-		for (int y = 0; y < mHeight; y++)
+		for (int y = 0; y < height; y++)
 		{
-			for (int x = 0; x < mWidth; x++)
+			for (int x = 0; x < width; x++)
 			{
 				if (probDist(generator) < mInitialWallRate)
 				{
-					mData[x + y * mWidth] = TileType::Wall;
+					data[toIndex(x, y, width)] = TileType::Wall;
 				}
 				else
 				{
-					mData[x + y * mWidth] = TileType::Room;
+					data[toIndex(x, y, width)] = TileType::Room;
 				}
 			}
 		}
+	}
 
-		std::vector<TileType> nextData;
-
-		nextData.resize(mWidth * mHeight, TileType::Wall);
+	//coarse   ũ fine ø. ¿  ٸ ĭ ִ  ĭ mJitterRate Ȯ ´.
+	template<typename RandomGenerator>
+	void upsample(const TileBuffer& coarse, int width, int height,
+		TileBuffer& fine, int fineWidth, int fineHeight, RandomGenerator& generator)
+	{
+		std::uniform_real_distribution<float> probDist(0.0f, 1.0f);
 
-		for (int i = 0; i < mIterationNum; i++)
+		for (int y = 0; y < fineHeight; y++)
 		{
-			for (int y = 0; y < mHeight; y++)
+			int cy = std::min(y >> 1, height - 1);
+
+			for (int x = 0; x < fineWidth; x++)
 			{
-				for (int x = 0; x < mWidth; x++)
+				int cx = std::min(x >> 1, width - 1);
+				TileType tile = coarse[toIndex(cx, cy, width)];
+
+				bool isEdge = (cx > 0 && coarse[toIndex(cx - 1, cy, width)] != tile) ||
+					(cx < width - 1 && coarse[toIndex(cx + 1, cy, width)] != tile) ||
+					(cy > 0 && coarse[toIndex(cx, cy - 1, width)] != tile) ||
+					(cy < height - 1 && coarse[toIndex(cx, cy + 1, width)] != tile);
+
+				if (isEdge && probDist(generator) < mJitterRate)
 				{
-					int adjust = getAdjustWallNum(x, y);
-
-					if (adjust >= mWallCriterionNum)
-					{
-						nextData[x + y*mWidth] = TileType::Wall;
-					}
-					else
-					{
-						nextData[x + y*mWidth] = TileType::Room;
-					}
+					tile = tile == TileType::Wall ? TileType::Room : TileType::Wall;
 				}
-			}
 
-			std::swap(mData, nextData);
+				fine[toIndex(x, y, fineWidth)] = tile;
+			}
 		}
 	}
 
-	int getWidth() const { return mWidth; }
-	int getHeight() const { return mHeight; }
-	TileType getData(int x, int y) const { return mData[x + y * mWidth]; }
+	//Ģ   ⺻ 4-5 迭 Ģ ǥ  mIterationNum  
+	RuleSchedule getSchedule() const
+	{
+		if (!mSchedule.empty())
+			return mSchedule;
+
+		return { RulePhase(getThresholdTableStep(mWallCriterionNum), mIterationNum) };
+	}
+
+	//fillArea ۾ ۿ area ٱ ĭ    ǵ.
+	void restoreOutside(const TileBuffer& data, int width, const Rectangle& copy, const Rectangle& area);
+
+	//runSchedule  ٲ ϸ 󰡸 area ʸ Ѵ.
+	bool runActive(const RuleSchedule& schedule, TileBuffer& data, int width, int height,
+		const Rectangle& area, const MapConstraint* constraint);
+
+	//constraint   ݺ    ִ     false ȯ. ҵǾ false.
+	bool runSchedule(const RuleSchedule& schedule, TileBuffer& data, int width, int height,
+		const MapConstraint* constraint);
+
+	bool isSatisfied(const MapConstraint* constraint) const
+	{
+		return constraint == nullptr || constraint->isSatisfied(computeStats(getView()));
+	}
+
+	//⺻  Ģ ִ ̿ ݰ.
+	const int AREA_MARGIN = 2;
 
-private:
-	int getAdjustWallNum(int x, int y);
 
-	int mWidth;
-	int mHeight;
 	int mIterationNum;
 	float mInitialWallRate;
 	int mWallCriterionNum;
-	
-	std::vector<TileType> mData;
+	RuleSchedule mSchedule;
+	int mLevelNum = 1;
+	int mLevelIteration = 2;
+	float mJitterRate = 0.2f;
+	bool mIsActiveTracking = false;
+	bool mIsEarlyReject = true;
+	float mEarlyRejectMargin = 0.05f; //ݺ ߿   ̹Ƿ ̸ŭ  ΰ ǴѴ.
+	int mBlockSize = 16;
+	GenerationControl mControl;
+	int mStepNum = 0;
+	int mStepTotal = 0;
+
+	TileBuffer mLevelData;
+	TileBuffer mNextData;
+	std::vector<char> mActive;
+	std::vector<char> mNextActive;
 };
 
 }
\ No newline at end of file
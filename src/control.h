@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <functional>
+#include "memoryBudget.h"
+
+namespace pmg
+{
+
+// ۾ ۿ ϱ  ū. 纻  ¸ Ѵ.
+class CancelToken
+{
+public:
+	CancelToken() : mIsCancelled(std::make_shared<std::atomic<bool>>(false)) { }
+
+	void cancel() { mIsCancelled->store(true); }
+	bool isCancelled() const { return mIsCancelled->load(std::memory_order_relaxed); }
+
+private:
+	std::shared_ptr<std::atomic<bool>> mIsCancelled;
+};
+
+//⿡ Ѱִ  ū (0 ~ 1) ݹ.
+class GenerationControl
+{
+public:
+	GenerationControl() : mMemoryScope(nullptr) { }
+	GenerationControl(const CancelToken& token, std::function<void(float)> onProgress = nullptr)
+		: mToken(token), mOnProgress(onProgress), mMemoryScope(nullptr)
+	{
+	}
+
+	//ҵǾų ̹  ޸ ѵ Ѿ.
+	bool isCancelled() const { return mToken.isCancelled() || isOverBudget(); }
+
+	void report(float progress) const
+	{
+		if (mOnProgress)
+			mOnProgress(progress);
+	}
+
+	const CancelToken& getToken() const { return mToken; }
+
+	//  ޸ ѵ. ѵ  isCancelled true Ǿ  ٷ .  BSP .
+	void setMemoryBudget(const MemoryBudget& budget) { mMemoryBudget = budget; }
+	const MemoryBudget& getMemoryBudget() const { return mMemoryBudget; }
+
+	//Ⱑ      纻 Ѵ.
+	void setMemoryScope(MemoryScope* scope) { mMemoryScope = scope; }
+	MemoryScope* getMemoryScope() const { return mMemoryScope; }
+
+	bool isOverBudget() const { return mMemoryScope != nullptr && mMemoryScope->isExceeded(); }
+
+	//    ޸𸮸 Ѵ. ѵ  false.
+	bool chargeMemory(std::int64_t bytes) const
+	{
+		return mMemoryScope == nullptr || mMemoryScope->charge(bytes);
+	}
+
+private:
+	CancelToken mToken;
+	std::function<void(float)> mOnProgress;
+	MemoryBudget mMemoryBudget;
+	MemoryScope* mMemoryScope;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "dungeon.h"
+
+const pmg::Room* pmg::Dungeon::findRoom(int floor, const Point& pos) const
+{
+	for (auto room : mRooms[floor])
+	{
+		if (room->isContain(pos))
+			return room;
+	}
+
+	return nullptr;
+}
+
+pmg::Rectangle pmg::Dungeon::getInnerOverlap(const Room& lhs, const Room& rhs) const
+{
+	//׵θ ̳    Ƿ ʳ ĺ.
+	int left = std::max(lhs.mX, rhs.mX) + 1;
+	int top = std::max(lhs.mY, rhs.mY) + 1;
+	int right = std::min(lhs.getRight(), rhs.getRight()) - 1;
+	int bottom = std::min(lhs.getBottom(), rhs.getBottom()) - 1;
+
+	return Rectangle(left, top, right - left + 1, bottom - top + 1);
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+#pragma once
+#include <random>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include "bsp.h"
+#include "control.h"
+#include "mapView.h"
+#include "random.h"
+#include "trace.h"
+
+namespace pmg
+{
+
+//mFloor  mPos  , mFloor + 1   ġ ö  ִ.
+struct Stair
+{
+	int mFloor;
+	Point mPos;
+};
+
+//  BSP    .   width * height * floorNum ũ ӵ  ϳ   
+//  Ʈ  createMap ״ ٽ .  ķ  ̿    ġ   ´.
+class Dungeon
+{
+public:
+	//ũ⳪   0 ϰų ü ۸    ŭ ũ   0 x 0  ǰ createMap false ȯѴ.
+	Dungeon(int width, int height, int floorNum,
+		int splitNum, float splitRange, float sizeMid, float sizeRange, int complexity)
+		: mWidth(width), mHeight(height), mFloorNum(floorNum),
+		mSplitNum(splitNum), mSplitRange(splitRange),
+		mSizeMid(sizeMid), mSizeRange(sizeRange), mComplexity(complexity),
+		mThreadNum(static_cast<int>(std::thread::hardware_concurrency()))
+	{
+		if (!isValidSize(mWidth, mHeight, mFloorNum))
+		{
+			mWidth = 0;
+			mHeight = 0;
+			mFloorNum = 0;
+		}
+
+		mData.resize(static_cast<std::size_t>(mWidth) * mHeight * mFloorNum, TileType::Wall);
+
+		for (int f = 0; f < mFloorNum; f++)
+		{
+			mFloors.emplace_back(new Leaf(0, 0, mWidth, mHeight));
+		}
+
+		mRooms.resize(mFloorNum);
+	}
+
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap()
+	{
+		std::random_device rd;
+		return createMap<RandomGenerator>(rd());
+	}
+
+	// seed  õ带 Ƿ     .
+	//̿   ġ  ų setControl ѱ ū ҵǸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		if (!isValid())
+			return false;
+
+		std::fill(mData.begin(), mData.end(), TileType::Wall);
+		mStairs.clear();
+
+		std::atomic<int> nextFloor(0);
+		int doneNum = 0;
+		std::mutex reportMutex;
+		std::vector<std::future<void>> workers;
+
+		auto work = [&]()
+		{
+			for (int f = nextFloor++; f < mFloorNum; f = nextFloor++)
+			{
+				if (mControl.isCancelled())
+					return;
+
+				createFloor<RandomGenerator>(f, getFloorSeed(seed, f));
+
+				std::lock_guard<std::mutex> lock(reportMutex);
+				mControl.report(0.9f * ++doneNum / mFloorNum);
+			}
+		};
+
+		for (int t = 1; t < std::min(mThreadNum, mFloorNum); t++)
+		{
+			workers.push_back(std::async(std::launch::async, work));
+		}
+
+		work();
+
+		for (auto& worker : workers)
+		{
+			worker.get();
+		}
+
+		if (mControl.isCancelled())
+			return false;
+
+		RandomGenerator generator(seed);
+
+		for (int f = 0; f + 1 < mFloorNum; f++)
+		{
+			if (!linkFloor(f, generator))
+				return false;
+		}
+
+		mControl.report(1.0f);
+
+		return true;
+	}
+
+	int getWidth() const { return mWidth; }
+	int getHeight() const { return mHeight; }
+	int getFloorNum() const { return mFloorNum; }
+
+	bool isValid() const { return mFloorNum > 0; }
+
+	//width * height * floorNum ĭ  ۿ   ִ.
+	static bool isValidSize(int width, int height, int floorNum)
+	{
+		return TileMap::isValidSize(width, height) && floorNum > 0 &&
+			static_cast<std::size_t>(width) * static_cast<std::size_t>(height) <=
+			TileBuffer().max_size() / static_cast<std::size_t>(floorNum);
+	}
+
+	TileType getData(int x, int y, int floor) const { return mData[getFloorOffset(floor) + toIndex(x, y, mWidth)]; }
+
+	MapView getFloor(int floor) const { return MapView(mData.data() + getFloorOffset(floor), mWidth, mHeight); }
+
+	//  ۸ directory  ޸  Ϸ ű.  ڿ̸ ٽ  ű.
+	// ų  ϸ ۸ ״ ΰ false ȯ.
+	bool setMappedStorage(const std::string& directory)
+	{
+		try
+		{
+			TileBuffer data(mData.begin(), mData.end(), MappedAllocator<TileType>(directory));
+			mData.swap(data);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	bool isMappedStorage() const { return mData.get_allocator().isMapped(); }
+
+	//  ̾ .
+	TileSpan getBuffer() const { return TileSpan(mData.data(), mData.size()); }
+
+	const std::vector<Stair>& getStairs() const { return mStairs; }
+	const std::vector<Room*>& getRooms(int floor) const { return mRooms[floor]; }
+
+	void setThreadNum(int threadNum) { mThreadNum = std::max(1, threadNum); }
+
+	//     ˸. ݹ   ۾ 忡 Ҹ  
+	// ȿ   ϳ,  Ŀ  Ҹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+private:
+	template<typename RandomGenerator>
+	void createFloor(int floor, unsigned int seed)
+	{
+		PMG_TRACE_SCOPE("Dungeon::createFloor");
+
+		RandomGenerator generator(seed);
+		Leaf& root = *mFloors[floor];
+
+		root.reset(0, 0, mWidth, mHeight);
+		root.splitTree(mSplitNum, mSplitRange, generator);
+		root.makeRoom(mSizeMid, mSizeRange, generator);
+		root.merge(mComplexity, generator, &mControl);
+		root.fillData(mWidth, mHeight, mData.data() + getFloorOffset(floor));
+
+		mRooms[floor].clear();
+		root.getLeafRooms(mRooms[floor]);
+	}
+
+	//floor  floor + 1   ġ       ϳ  ´.
+	//floor  ö      ؼ    Ѵ.
+	template<typename RandomGenerator>
+	bool linkFloor(int floor, RandomGenerator& generator)
+	{
+		const Room* arrival = nullptr;
+
+		if (!mStairs.empty())
+			arrival = findRoom(floor, mStairs.back().mPos);
+
+		std::vector<Rectangle> cands;
+		std::vector<Rectangle> farCands;
+
+		for (auto upper : mRooms[floor])
+		{
+			for (auto lower : mRooms[floor + 1])
+			{
+				Rectangle overlap = getInnerOverlap(*upper, *lower);
+
+				if (overlap.mWidth <= 0 || overlap.mHeight <= 0)
+					continue;
+
+				cands.push_back(overlap);
+
+				if (arrival == nullptr || upper->getGroup() != arrival->getGroup())
+					farCands.push_back(overlap);
+			}
+		}
+
+		if (!farCands.empty())
+			std::swap(cands, farCands);
+
+		//ö ܰ  ĭ  ٽ ̴´.  1ĭ¥ ħ ϳ̸ .
+		for (int tryNum = 0; tryNum < 8 && !cands.empty(); tryNum++)
+		{
+			std::uniform_int_distribution<int> candDist(0, static_cast<int>(cands.size()) - 1);
+			const Rectangle& area = cands[candDist(generator)];
+
+			std::uniform_int_distribution<int> xDist(area.mX, area.getRight());
+			std::uniform_int_distribution<int> yDist(area.mY, area.getBottom());
+			Point pos(xDist(generator), yDist(generator));
+
+			if (getData(pos.mX, pos.mY, floor) != TileType::Room)
+				continue;
+
+			mData[getFloorOffset(floor) + toIndex(pos.mX, pos.mY, mWidth)] = TileType::DownStair;
+			mData[getFloorOffset(floor + 1) + toIndex(pos.mX, pos.mY, mWidth)] = TileType::UpStair;
+			mStairs.push_back({ floor, pos });
+
+			return true;
+		}
+
+		return false;
+	}
+
+	const Room* findRoom(int floor, const Point& pos) const;
+	Rectangle getInnerOverlap(const Room& lhs, const Room& rhs) const;
+
+	std::size_t getFloorOffset(int floor) const { return static_cast<std::size_t>(mWidth) * mHeight * floor; }
+
+	unsigned int getFloorSeed(unsigned int seed, int floor) const
+	{
+		return static_cast<unsigned int>(SplitMix64::mix(seed ^ SplitMix64::mix(static_cast<std::uint64_t>(floor))));
+	}
+
+	int mWidth;
+	int mHeight;
+	int mFloorNum;
+	int mSplitNum;
+	float mSplitRange;
+	float mSizeMid;
+	float mSizeRange;
+	int mComplexity;
+	int mThreadNum;
+	GenerationControl mControl;
+
+	TileBuffer mData;
+	std::vector<std::unique_ptr<Leaf>> mFloors;
+	std::vector<std::vector<Room*>> mRooms; //  
+	std::vector<Stair> mStairs;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "mapView.h"
+
+namespace pmg
+{
+
+// ϳ  ۾ 尡    .
+// ⸦  Լ make ޴´. make   ٲ ʰ, ۾ 帶 ó     ҷ
+//   ⸦ . Ʈ, ۾ , Ÿ     ´  Ⱑ Ƿ
+//worker ȣ ġ    ÿ   ְ, û ⸦   ʾ ۵  ٽ .
+// ʴ worker ⸦  ʴ´. make  忡 ÿ Ҹ  ִ.
+//) GeneratorPool<BSP> pool([]() { return std::unique_ptr<BSP>(new BSP(200, 200, 6, 0.2f, 0.6f, 0.2f, 1)); }, 4);
+template<typename Generator>
+class GeneratorPool
+{
+public:
+	typedef std::function<std::unique_ptr<Generator>()> Factory;
+
+	GeneratorPool(Factory make, int workerNum) : mMake(std::move(make)), mWorkers(std::max(0, workerNum))
+	{
+	}
+
+	int getWorkerNum() const { return static_cast<int>(mWorkers.size()); }
+
+	//worker    . ó θ .
+	//setControló ۾ ٸ  ⿡ ִ´.  ū worker    ִ.
+	Generator& getWorker(int worker)
+	{
+		std::unique_ptr<Generator>& generator = mWorkers[worker];
+
+		if (generator == nullptr)
+			generator = mMake();
+
+		return *generator;
+	}
+
+	//  worker     getView(worker)   ִ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(int worker, unsigned int seed)
+	{
+		return getWorker(worker).template createMap<RandomGenerator>(seed);
+	}
+
+	//   worker  view.
+	MapView getView(int worker) const
+	{
+		return mWorkers[worker] != nullptr ? mWorkers[worker]->getView() : MapView();
+	}
+
+private:
+	const Factory mMake;
+	std::vector<std::unique_ptr<Generator>> mWorkers; //峢  ĳ  ǵ帮 ʵ  ҴѴ
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace pmg
+{
+
+//64Ʈ FNV-1a.  ó   ̾ ؽ  .
+class Fnv1a
+{
+public:
+	Fnv1a() : mHash(14695981039346656037ull) { }
+
+	void add(const void* data, std::size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			mHash ^= bytes[i];
+			mHash *= 1099511628211ull;
+		}
+	}
+
+	//, Ǽ, enum Ʈ ״ ִ´. Ǽ Ʈ  ƾ  ̴.
+	template<typename T>
+	void add(T value)
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "add needs a scalar value");
+		add(&value, sizeof(value));
+	}
+
+	void addString(const char* text)
+	{
+		add(text, std::strlen(text) + 1);
+	}
+
+	std::uint64_t get() const { return mHash; }
+
+private:
+	std::uint64_t mHash;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,525 @@
+#include <future>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include "image.h"
+
+//PNG ϴ ʺ  ִ밪. PPM  ѵ .
+static const std::int64_t IMAGE_SIZE_MAX = 0x7FFFFFFF;
+
+//  ̹ ũ. ĭ ų,   IMAGE_SIZE_MAX Ѱų,
+//ึ (ʺ * pixelSize + rowExtra) Ʈ ۸ size_t Ÿ   false.
+static bool getImageSize(const pmg::MapView& view, const pmg::ImageOption& option, std::int64_t pixelSize,
+	std::int64_t rowExtra, OUT int& width, OUT int& height)
+{
+	if (view.getWidth() <= 0 || view.getHeight() <= 0)
+		return false;
+
+	std::int64_t scale = std::max(1, option.mScale);
+	std::int64_t scaledWidth = view.getWidth() * scale;
+	std::int64_t scaledHeight = view.getHeight() * scale;
+
+	if (scaledWidth > IMAGE_SIZE_MAX || scaledHeight > IMAGE_SIZE_MAX)
+		return false;
+
+	std::uint64_t rowSize = static_cast<std::uint64_t>(scaledWidth * pixelSize + rowExtra);
+
+	if (rowSize > std::numeric_limits<std::size_t>::max() / static_cast<std::uint64_t>(scaledHeight))
+		return false;
+
+	width = static_cast<int>(scaledWidth);
+	height = static_cast<int>(scaledHeight);
+
+	return true;
+}
+
+// [0, height) threadNum   func( ,  ,  ȣ) ķ θ.   ȯ.
+//  func θ ʰ 0.
+template<typename Func>
+static int forEachRows(int height, int threadNum, Func func)
+{
+	if (height <= 0)
+		return 0;
+
+	int chunkNum = std::max(1, std::min(threadNum, height));
+	int chunkHeight = (height + chunkNum - 1) / chunkNum;
+	std::vector<std::future<void>> tasks;
+
+	chunkNum = std::max(1, (height + chunkHeight - 1) / chunkHeight);
+
+	for (int c = 1; c < chunkNum; c++)
+	{
+		int begin = c * chunkHeight;
+		int end = std::min(height, begin + chunkHeight);
+
+		tasks.push_back(std::async(std::launch::async, [=]() { func(begin, end, c); }));
+	}
+
+	func(0, std::min(height, chunkHeight), 0);
+
+	for (auto& task : tasks)
+	{
+		task.get();
+	}
+
+	return chunkNum;
+}
+
+void pmg::encodePpm(const MapView& view, const ImageOption& option, OUT std::vector<std::uint8_t>& bytes)
+{
+	int width = 0;
+	int height = 0;
+
+	if (!getImageSize(view, option, 3, 0, width, height))
+		return;
+
+	int scale = std::max(1, option.mScale);
+	std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+
+	std::size_t offset = bytes.size() + header.size();
+	std::size_t rowSize = static_cast<std::size_t>(width) * 3;
+
+	bytes.insert(bytes.end(), header.begin(), header.end());
+	bytes.resize(offset + rowSize * height);
+
+	forEachRows(view.getHeight(), option.mThreadNum, [&](int begin, int end, int)
+	{
+		for (int y = begin; y < end; y++)
+		{
+			std::uint8_t* row = &bytes[offset + rowSize * y * scale];
+			std::uint8_t* pixel = row;
+
+			for (auto tile : view.getRow(y))
+			{
+				Color color = option.getColor(tile);
+
+				for (int s = 0; s < scale; s++)
+				{
+					*pixel++ = color.mR;
+					*pixel++ = color.mG;
+					*pixel++ = color.mB;
+				}
+			}
+
+			// Ÿ ࿡  ȼ   .
+			for (int s = 1; s < scale; s++)
+			{
+				std::copy(row, row + rowSize, row + rowSize * s);
+			}
+		}
+	});
+}
+
+namespace
+{
+
+//deflate Ʈ Ʈ.  Ʈ ä.
+class BitWriter
+{
+public:
+	BitWriter(std::vector<std::uint8_t>& bytes) : mBytes(bytes), mBuffer(0), mBitNum(0) { }
+
+	void write(std::uint32_t value, int bitNum)
+	{
+		mBuffer |= value << mBitNum;
+		mBitNum += bitNum;
+
+		while (mBitNum >= 8)
+		{
+			mBytes.push_back(static_cast<std::uint8_t>(mBuffer));
+			mBuffer >>= 8;
+			mBitNum -= 8;
+		}
+	}
+
+	// ڵ  Ʈ .
+	void writeCode(std::uint32_t code, int bitNum)
+	{
+		std::uint32_t reversed = 0;
+
+		for (int i = 0; i < bitNum; i++)
+		{
+			reversed |= ((code >> i) & 1) << (bitNum - 1 - i);
+		}
+
+		write(reversed, bitNum);
+	}
+
+	void flush()
+	{
+		if (mBitNum > 0)
+			write(0, 8 - mBitNum);
+	}
+
+private:
+	std::vector<std::uint8_t>& mBytes;
+	std::uint32_t mBuffer;
+	int mBitNum;
+};
+
+const int LENGTH_BASES[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const int LENGTH_EXTRAS[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const int DISTANCE_BASES[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const int DISTANCE_EXTRAS[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+const std::size_t MAX_MATCH = 258;
+const std::size_t MAX_DISTANCE = 32768;
+const std::uint32_t ADLER_BASE = 65521;
+
+struct Code
+{
+	std::uint16_t mBits; //   ڵ
+	std::uint8_t mBitNum;
+};
+
+//  ̺ ͷ /  ȣ. ɺ Ʈ      д.
+const std::vector<Code>& getFixedCodes()
+{
+	static const std::vector<Code> codes = []()
+	{
+		std::vector<Code> res(288);
+
+		for (int symbol = 0; symbol < 288; symbol++)
+		{
+			std::uint32_t code;
+			int bitNum;
+
+			if (symbol < 144)
+			{
+				code = 0x30 + symbol;
+				bitNum = 8;
+			}
+			else if (symbol < 256)
+			{
+				code = 0x190 + symbol - 144;
+				bitNum = 9;
+			}
+			else if (symbol < 280)
+			{
+				code = symbol - 256;
+				bitNum = 7;
+			}
+			else
+			{
+				code = 0xc0 + symbol - 280;
+				bitNum = 8;
+			}
+
+			std::uint32_t reversed = 0;
+
+			for (int i = 0; i < bitNum; i++)
+			{
+				reversed |= ((code >> i) & 1) << (bitNum - 1 - i);
+			}
+
+			res[symbol].mBits = static_cast<std::uint16_t>(reversed);
+			res[symbol].mBitNum = static_cast<std::uint8_t>(bitNum);
+		}
+
+		return res;
+	}();
+
+	return codes;
+}
+
+void writeSymbol(BitWriter& writer, int symbol)
+{
+	const Code& code = getFixedCodes()[symbol];
+
+	writer.write(code.mBits, code.mBitNum);
+}
+
+void writeMatch(BitWriter& writer, int length, int distance)
+{
+	int code = static_cast<int>(std::upper_bound(LENGTH_BASES, LENGTH_BASES + 29, length) - LENGTH_BASES) - 1;
+
+	writeSymbol(writer, 257 + code);
+	writer.write(length - LENGTH_BASES[code], LENGTH_EXTRAS[code]);
+
+	code = static_cast<int>(std::upper_bound(DISTANCE_BASES, DISTANCE_BASES + 30, distance) - DISTANCE_BASES) - 1;
+
+	writer.writeCode(code, 5);
+	writer.write(distance - DISTANCE_BASES[code], DISTANCE_EXTRAS[code]);
+}
+
+//data[begin, end)    Ѵ.   Ÿ  ̾ų    찡 κ̶
+//Ÿ 1    Ѵ. begin ʵ   Ƿ  迡   ʴ´.
+//  ƴϸ  stored  Ʈ 缭 ٸ   ״ ̾  ְ Ѵ.
+void deflateRange(const std::vector<std::uint8_t>& data, std::size_t begin, std::size_t end,
+	std::size_t stride, bool isLast, OUT std::vector<std::uint8_t>& bytes)
+{
+	BitWriter writer(bytes);
+	std::size_t distances[2] = { 1, stride };
+
+	writer.write(isLast ? 1 : 0, 1);
+	writer.write(1, 2);
+
+	std::size_t pos = begin;
+
+	while (pos < end)
+	{
+		std::size_t bestLength = 0;
+		std::size_t bestDistance = 0;
+
+		for (auto distance : distances)
+		{
+			if (distance > pos || distance > MAX_DISTANCE)
+				continue;
+
+			std::size_t length = 0;
+			std::size_t maxLength = std::min(MAX_MATCH, end - pos);
+
+			while (length < maxLength && data[pos + length] == data[pos + length - distance])
+				length++;
+
+			if (length > bestLength)
+			{
+				bestLength = length;
+				bestDistance = distance;
+			}
+		}
+
+		if (bestLength >= 3)
+		{
+			writeMatch(writer, static_cast<int>(bestLength), static_cast<int>(bestDistance));
+			pos += bestLength;
+		}
+		else
+		{
+			writeSymbol(writer, data[pos]);
+			pos++;
+		}
+	}
+
+	writeSymbol(writer, 256);
+
+	if (!isLast)
+		writer.write(0, 3);
+
+	writer.flush();
+
+	if (!isLast)
+	{
+		const std::uint8_t sync[4] = { 0x00, 0x00, 0xff, 0xff };
+		bytes.insert(bytes.end(), sync, sync + 4);
+	}
+}
+
+std::uint32_t getAdler32(const std::uint8_t* data, std::size_t size)
+{
+	std::uint32_t a = 1;
+	std::uint32_t b = 0;
+
+	while (size > 0)
+	{
+		//5552Ʈ    ص ġ ʴ´.
+		std::size_t block = std::min<std::size_t>(size, 5552);
+
+		for (std::size_t i = 0; i < block; i++)
+		{
+			a += data[i];
+			b += a;
+		}
+
+		a %= ADLER_BASE;
+		b %= ADLER_BASE;
+		data += block;
+		size -= block;
+	}
+
+	return b << 16 | a;
+}
+
+//  checksum  size   checksum ģ.
+std::uint32_t combineAdler32(std::uint32_t front, std::uint32_t back, std::size_t size)
+{
+	std::uint32_t rem = static_cast<std::uint32_t>(size % ADLER_BASE);
+	std::uint32_t a = front & 0xffff;
+	std::uint32_t b = static_cast<std::uint32_t>((static_cast<std::uint64_t>(rem) * a) % ADLER_BASE);
+
+	a += (back & 0xffff) + ADLER_BASE - 1;
+	b += ((front >> 16) & 0xffff) + ((back >> 16) & 0xffff) + ADLER_BASE - rem;
+
+	a %= ADLER_BASE;
+	b %= ADLER_BASE;
+
+	return b << 16 | a;
+}
+
+std::uint32_t getCrc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0)
+{
+	static const std::vector<std::uint32_t> table = []()
+	{
+		std::vector<std::uint32_t> res(256);
+
+		for (std::uint32_t i = 0; i < 256; i++)
+		{
+			std::uint32_t c = i;
+
+			for (int k = 0; k < 8; k++)
+			{
+				c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+			}
+
+			res[i] = c;
+		}
+
+		return res;
+	}();
+
+	crc = ~crc;
+
+	for (std::size_t i = 0; i < size; i++)
+	{
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+
+	return ~crc;
+}
+
+void writeUint32(std::uint32_t value, OUT std::vector<std::uint8_t>& bytes)
+{
+	bytes.push_back(static_cast<std::uint8_t>(value >> 24));
+	bytes.push_back(static_cast<std::uint8_t>(value >> 16));
+	bytes.push_back(static_cast<std::uint8_t>(value >> 8));
+	bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+void writeChunk(const char* type, const std::vector<std::uint8_t>& data, OUT std::vector<std::uint8_t>& bytes)
+{
+	writeUint32(static_cast<std::uint32_t>(data.size()), bytes);
+
+	std::size_t typePos = bytes.size();
+
+	bytes.insert(bytes.end(), type, type + 4);
+	bytes.insert(bytes.end(), data.begin(), data.end());
+	writeUint32(getCrc32(&bytes[typePos], bytes.size() - typePos), bytes);
+}
+
+bool writeFile(const std::string& path, const std::vector<std::uint8_t>& bytes)
+{
+	std::ofstream stream(path, std::ios::binary);
+
+	if (!stream.is_open())
+		return false;
+
+	stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+
+	return stream.good();
+}
+
+}
+
+void pmg::encodePng(const MapView& view, const ImageOption& option, OUT std::vector<std::uint8_t>& bytes)
+{
+	//PNG ʺ ̰ 0 ̹  ʴ´.
+	// (0)  Ʈ + ȼ ȷƮ ȣ  Ʈ.
+	int width = 0;
+	int height = 0;
+
+	if (!getImageSize(view, option, 1, 1, width, height))
+		return;
+
+	int scale = std::max(1, option.mScale);
+	std::size_t stride = static_cast<std::size_t>(width) + 1;
+	std::vector<std::uint8_t> raw(stride * height);
+
+	int chunkNum = forEachRows(view.getHeight(), option.mThreadNum, [&](int begin, int end, int)
+	{
+		for (int y = begin; y < end; y++)
+		{
+			std::uint8_t* row = &raw[stride * y * scale];
+			std::uint8_t* pixel = row + 1;
+
+			row[0] = 0;
+
+			for (auto tile : view.getRow(y))
+			{
+				pixel = std::fill_n(pixel, scale, static_cast<std::uint8_t>(tile));
+			}
+
+			for (int s = 1; s < scale; s++)
+			{
+				std::copy(row, row + stride, row + stride * s);
+			}
+		}
+	});
+
+	//ٸ  ൵ ϹǷ raw  ä  Ѵ.
+	std::vector<std::vector<std::uint8_t>> deflated(chunkNum);
+	std::vector<std::uint32_t> adlers(chunkNum);
+	std::vector<std::size_t> sizes(chunkNum);
+
+	forEachRows(view.getHeight(), option.mThreadNum, [&](int begin, int end, int chunk)
+	{
+		std::size_t from = stride * begin * scale;
+		std::size_t to = stride * end * scale;
+
+		deflateRange(raw, from, to, stride, end == view.getHeight(), deflated[chunk]);
+		adlers[chunk] = getAdler32(&raw[from], to - from);
+		sizes[chunk] = to - from;
+	});
+
+	std::vector<std::uint8_t> zlib = { 0x78, 0x01 };
+	std::uint32_t adler = 1;
+
+	for (int c = 0; c < chunkNum; c++)
+	{
+		zlib.insert(zlib.end(), deflated[c].begin(), deflated[c].end());
+		adler = combineAdler32(adler, adlers[c], sizes[c]);
+	}
+
+	writeUint32(adler, zlib);
+
+	const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	bytes.insert(bytes.end(), signature, signature + 8);
+
+	std::vector<std::uint8_t> header;
+	writeUint32(width, header);
+	writeUint32(height, header);
+	header.push_back(8); //Ʈ 
+	header.push_back(3); //ȷƮ
+	header.push_back(0);
+	header.push_back(0);
+	header.push_back(0);
+	writeChunk("IHDR", header, bytes);
+
+	std::vector<std::uint8_t> palette;
+
+	for (auto& color : option.mPalette)
+	{
+		palette.push_back(color.mR);
+		palette.push_back(color.mG);
+		palette.push_back(color.mB);
+	}
+
+	writeChunk("PLTE", palette, bytes);
+	writeChunk("IDAT", zlib, bytes);
+	writeChunk("IEND", std::vector<std::uint8_t>(), bytes);
+}
+
+bool pmg::toPpmFile(const MapView& view, const std::string& path, const ImageOption& option)
+{
+	std::vector<std::uint8_t> bytes;
+	encodePpm(view, option, bytes);
+
+	if (bytes.empty())
+		return false;
+
+	return writeFile(path, bytes);
+}
+
+bool pmg::toPngFile(const MapView& view, const std::string& path, const ImageOption& option)
+{
+	std::vector<std::uint8_t> bytes;
+	encodePng(view, option, bytes);
+
+	if (bytes.empty())
+		return false;
+
+	return writeFile(path, bytes);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include "types.h"
+#include "mapView.h"
+
+#ifndef OUT
+#define OUT
+#endif
+
+namespace pmg
+{
+
+struct Color
+{
+	Color() : mR(0), mG(0), mB(0) { }
+	Color(std::uint8_t r, std::uint8_t g, std::uint8_t b) : mR(r), mG(g), mB(b) { }
+
+	std::uint8_t mR;
+	std::uint8_t mG;
+	std::uint8_t mB;
+};
+
+//Ÿ  Ȯ . Ÿ ϳ mScale x mScale ȼ ȴ.
+struct ImageOption
+{
+	ImageOption()
+		: mPalette({ Color(40, 40, 40), Color(200, 180, 120), Color(230, 230, 230), Color(180, 60, 40),
+			Color(60, 140, 220), Color(40, 80, 180) }),
+		mScale(1), mThreadNum(static_cast<int>(std::thread::hardware_concurrency()))
+	{
+	}
+
+	void setColor(TileType tile, Color color) { mPalette[static_cast<int>(tile)] = color; }
+	Color getColor(TileType tile) const { return mPalette[static_cast<int>(tile)]; }
+
+	std::vector<Color> mPalette; //TileType 
+	int mScale;
+	int mThreadNum; //  ڵ  
+};
+
+//̳ʸ PPM(P6).   ȼ 3Ʈ.
+void encodePpm(const MapView& view, const ImageOption& option, OUT std::vector<std::uint8_t>& bytes);
+
+//ȷƮ PNG.   ٸ 忡   deflate  ̾δ.
+void encodePng(const MapView& view, const ImageOption& option, OUT std::vector<std::uint8_t>& bytes);
+
+//0 x 0 ó ĭ ų     PNG ѵ 2^31 - 1 Ѵ view ڵ ʴ´.
+//encode bytes ״ ΰ  Լ false ȯѴ.
+bool toPpmFile(const MapView& view, const std::string& path, const ImageOption& option = ImageOption());
+bool toPngFile(const MapView& view, const std::string& path, const ImageOption& option = ImageOption());
+
+template<typename Generator>
+bool toPpmFile(const Generator& generator, const std::string& path, const ImageOption& option = ImageOption())
+{
+	return toPpmFile(generator.getView(), path, option);
+}
+
+template<typename Generator>
+bool toPngFile(const Generator& generator, const std::string& path, const ImageOption& option = ImageOption())
+{
+	return toPngFile(generator.getView(), path, option);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <functional>
+#include "mapCache.h"
+#include "serialize.h"
+
+//ũ  Ӹ. "PMGC", , Ű ؽ,  ؽ, ʺ, ̸ Ʋ   ̷  ڿ RLE  ´.
+static const char FILE_MAGIC[4] = { 'P', 'M', 'G', 'C' };
+static const std::size_t FILE_HEADER_SIZE = 4 + 4 + 8 + 8 + 4 + 4;
+
+static void writeFixed(std::uint64_t value, int size, OUT std::vector<std::uint8_t>& bytes)
+{
+	for (int i = 0; i < size; i++)
+	{
+		bytes.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+	}
+}
+
+static std::uint64_t readFixed(const std::uint8_t* data, int size)
+{
+	std::uint64_t value = 0;
+
+	for (int i = 0; i < size; i++)
+	{
+		value |= static_cast<std::uint64_t>(data[i]) << (i * 8);
+	}
+
+	return value;
+}
+
+std::shared_ptr<const pmg::CachedMap> pmg::MapCache::find(const Key& key)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto iter = mIndex.find(key.mHash);
+
+		//ؽø  ٸ û̸   .
+		if (iter != mIndex.end() && iter->second->mKey == key)
+		{
+			//  Űܼ  ֱٿ   .
+			mEntries.splice(mEntries.begin(), mEntries, iter->second);
+			mHitNum++;
+
+			return iter->second->mMap;
+		}
+	}
+
+	std::shared_ptr<const CachedMap> map = loadFile(key);
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (map == nullptr)
+	{
+		mMissNum++;
+		return nullptr;
+	}
+
+	mDiskHitNum++;
+	insertMemory(key, map);
+
+	return map;
+}
+
+void pmg::MapCache::insert(const Key& key, const std::shared_ptr<const CachedMap>& map)
+{
+	saveFile(key, *map);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	insertMemory(key, map);
+}
+
+void pmg::MapCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mEntries.clear();
+	mIndex.clear();
+	mByteSize = 0;
+}
+
+void pmg::MapCache::insertMemory(const Key& key, const std::shared_ptr<const CachedMap>& map)
+{
+	auto iter = mIndex.find(key.mHash);
+
+	if (iter != mIndex.end())
+	{
+		mByteSize -= iter->second->mMap->getByteSize();
+		mEntries.erase(iter->second);
+		mIndex.erase(iter);
+	}
+
+	//꺸 ū  ϳ ũ .
+	if (map->getByteSize() > mByteBudget)
+		return;
+
+	mEntries.push_front({ key, map });
+	mIndex[key.mHash] = mEntries.begin();
+	mByteSize += map->getByteSize();
+
+	while (mByteSize > mByteBudget)
+	{
+		const Entry& last = mEntries.back();
+
+		mByteSize -= last.mMap->getByteSize();
+		mIndex.erase(last.mKey.mHash);
+		mEntries.pop_back();
+	}
+}
+
+std::string pmg::MapCache::getPath(const Key& key) const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.pmg", static_cast<unsigned long long>(key.mHash));
+
+	return mDirectory + "/" + name;
+}
+
+std::shared_ptr<const pmg::CachedMap> pmg::MapCache::loadFile(const Key& key) const
+{
+	if (mDirectory.empty())
+		return nullptr;
+
+	std::ifstream stream(getPath(key), std::ios::binary);
+
+	if (!stream.is_open())
+		return nullptr;
+
+	std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	//ٸ  ų ٸ û ̸    ٽ .
+	if (bytes.size() < FILE_HEADER_SIZE || !std::equal(FILE_MAGIC, FILE_MAGIC + 4, bytes.begin()))
+		return nullptr;
+
+	const std::uint8_t* header = bytes.data() + 4;
+
+	if (readFixed(header, 4) != VERSION || readFixed(header + 4, 8) != key.mHash ||
+		readFixed(header + 12, 8) != key.mParamHash ||
+		static_cast<std::int32_t>(readFixed(header + 20, 4)) != key.mWidth ||
+		static_cast<std::int32_t>(readFixed(header + 24, 4)) != key.mHeight)
+	{
+		return nullptr;
+	}
+
+	MapDecoder decoder;
+
+	// ϵ   .  ¾Ƶ  ũⰡ ٸ  ʴ´.
+	if (!decoder.feed(bytes.data() + FILE_HEADER_SIZE, bytes.size() - FILE_HEADER_SIZE) || !decoder.isComplete() ||
+		decoder.getWidth() != key.mWidth || decoder.getHeight() != key.mHeight)
+	{
+		return nullptr;
+	}
+
+	return std::make_shared<const CachedMap>(decoder.getView());
+}
+
+void pmg::MapCache::saveFile(const Key& key, const CachedMap& map) const
+{
+	if (mDirectory.empty())
+		return;
+
+	std::vector<std::uint8_t> bytes(FILE_MAGIC, FILE_MAGIC + 4);
+
+	writeFixed(VERSION, 4, bytes);
+	writeFixed(key.mHash, 8, bytes);
+	writeFixed(key.mParamHash, 8, bytes);
+	writeFixed(static_cast<std::uint32_t>(key.mWidth), 4, bytes);
+	writeFixed(static_cast<std::uint32_t>(key.mHeight), 4, bytes);
+
+	encodeRle(map, bytes);
+
+	//   ٸ 尡  ʵ ӽ Ͽ   ̸ ٲ۴.
+	std::string path = getPath(key);
+	std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+	{
+		std::ofstream stream(tempPath, std::ios::binary);
+
+		if (!stream.is_open())
+			return;
+
+		stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	}
+
+	if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+		std::remove(tempPath.c_str());
+}
\ No newline at end of file
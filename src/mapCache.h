@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "types.h"
+#include "mapView.h"
+#include "hash.h"
+#include "random.h"
+
+namespace pmg
+{
+
+//ĳÿ  ϼ .  ڿ ٲ Ƿ  尡  о ȴ.
+class CachedMap : public TileMap
+{
+public:
+	CachedMap(const MapView& view) : TileMap(view.getWidth(), view.getHeight())
+	{
+		TileSpan buffer = view.getBuffer();
+
+		std::copy(buffer.begin(), buffer.end(), mData.begin());
+	}
+
+	std::size_t getByteSize() const { return mData.size() * sizeof(TileType); }
+};
+
+//( , ,  , seed)  Ű ϼ  Ѵ.
+//޸𸮿 byteBudget  ʰ ֱٿ  ʺ , directory ָ RLE  ũ .
+// û ٽ      ״ ش.
+class MapCache
+{
+public:
+	//Ű  .   seed  ̳ ũ   ٲ ÷    ʰ Ѵ.
+	static const std::uint32_t VERSION = 1;
+
+	// ã Ű. ؽð 쿬 ĵ ٸ   ʵ  ؽÿ ũ⵵   ٴϸ ȮѴ.
+	struct Key
+	{
+		std::uint64_t mHash;
+		std::uint64_t mParamHash;
+		int mWidth;
+		int mHeight;
+
+		bool operator==(const Key& other) const
+		{
+			return mHash == other.mHash && mParamHash == other.mParamHash &&
+				mWidth == other.mWidth && mHeight == other.mHeight;
+		}
+	};
+
+	MapCache(std::size_t byteBudget, const std::string& directory = "")
+		: mByteBudget(byteBudget), mByteSize(0), mDirectory(directory), mHitNum(0), mDiskHitNum(0), mMissNum(0)
+	{
+	}
+
+	//getParamHash() ϴ  seed .  generator.createMap(seed)  Ѵ.
+	// ϰų ҵǸ nullptr.   ĳÿ з    ִ.
+	template<typename RandomGenerator = std::mt19937, typename Generator>
+	std::shared_ptr<const CachedMap> getMap(Generator& generator, unsigned int seed)
+	{
+		Key key = getKey<RandomGenerator>(generator, seed);
+		std::shared_ptr<const CachedMap> map = find(key);
+
+		if (map != nullptr)
+			return map;
+
+		//  ʰ Ѵ.  Ű ÿ     ´.
+		if (!generator.template createMap<RandomGenerator>(seed))
+			return nullptr;
+
+		map = std::make_shared<const CachedMap>(generator.getView());
+		insert(key, map);
+
+		return map;
+	}
+
+	template<typename RandomGenerator = std::mt19937, typename Generator>
+	Key getKey(const Generator& generator, unsigned int seed) const
+	{
+		Fnv1a hash;
+		std::uint64_t paramHash = generator.getParamHash();
+		MapView view = generator.getView();
+
+		hash.add(VERSION);
+		hash.add(paramHash);
+		hash.addString(RandomTag<RandomGenerator>::get());
+		hash.add(seed);
+
+		return { hash.get(), paramHash, view.getWidth(), view.getHeight() };
+	}
+
+	//޸, ũ  ã´. ũ ã ޸𸮿 ø.
+	std::shared_ptr<const CachedMap> find(const Key& key);
+	void insert(const Key& key, const std::shared_ptr<const CachedMap>& map);
+
+	//޸𸮿 ִ ʸ .
+	void clear();
+
+	//ٸ 尡 getMap θ ߿   ִ.
+	std::size_t getByteSize() const { return mByteSize.load(std::memory_order_relaxed); }
+	int getHitNum() const { return mHitNum.load(std::memory_order_relaxed); }
+	int getDiskHitNum() const { return mDiskHitNum.load(std::memory_order_relaxed); }
+	int getMissNum() const { return mMissNum.load(std::memory_order_relaxed); }
+
+private:
+	struct Entry
+	{
+		Key mKey;
+		std::shared_ptr<const CachedMap> mMap;
+	};
+
+	//mMutex  ¿ θ.
+	void insertMemory(const Key& key, const std::shared_ptr<const CachedMap>& map);
+
+	std::shared_ptr<const CachedMap> loadFile(const Key& key) const;
+	void saveFile(const Key& key, const CachedMap& map) const;
+	std::string getPath(const Key& key) const;
+
+	std::size_t mByteBudget;
+	std::atomic<std::size_t> mByteSize; //ٲٴ  mMutex ȿ Ѵ
+	std::string mDirectory;
+
+	std::mutex mMutex;
+	std::list<Entry> mEntries; // ֱٿ  
+	std::unordered_map<std::uint64_t, std::list<Entry>::iterator> mIndex;
+
+	std::atomic<int> mHitNum;
+	std::atomic<int> mDiskHitNum;
+	std::atomic<int> mMissNum;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "types.h"
+#include "storage.h"
+#include "postProcess.h"
+
+namespace pmg
+{
+
+//ӵ Ÿ   б  . std::span<const TileType> .
+class TileSpan
+{
+public:
+	TileSpan() : mData(nullptr), mSize(0) { }
+	TileSpan(const TileType* data, std::size_t size) : mData(data), mSize(size) { }
+
+	const TileType* begin() const { return mData; }
+	const TileType* end() const { return mData + mSize; }
+	const TileType* getData() const { return mData; }
+	std::size_t size() const { return mSize; }
+
+	TileType operator[](std::size_t idx) const { return mData[idx]; }
+
+private:
+	const TileType* mData;
+	std::size_t mSize;
+};
+
+//  ۸    .  켱 ӵ width * height Ÿ Ų.
+class MapView
+{
+public:
+	MapView() : mData(nullptr), mWidth(0), mHeight(0) { }
+	MapView(const TileType* data, int width, int height) : mData(data), mWidth(width), mHeight(height) { }
+
+	int getWidth() const { return mWidth; }
+	int getHeight() const { return mHeight; }
+	TileType getData(int x, int y) const { return mData[toIndex(x, y, mWidth)]; }
+
+	TileSpan getRow(int y) const { return TileSpan(mData + toIndex(0, y, mWidth), mWidth); }
+	TileSpan getBuffer() const { return TileSpan(mData, static_cast<std::size_t>(mWidth) * mHeight); }
+
+	const MapView& getView() const { return *this; }
+
+private:
+	const TileType* mData;
+	int mWidth;
+	int mHeight;
+};
+
+//Ÿ ۸    κ.   ⵵ ̰ ϰų getView() ϸ
+//toTextFile̳ computeStats  ó ״   ִ.
+class TileMap
+{
+public:
+	//ũⰡ 0 ϰų ۸    ŭ ũ 0 x 0  ǰ createMap false ȯѴ.
+	TileMap(int width, int height) : mWidth(0), mHeight(0)
+	{
+		resize(width, height);
+	}
+
+	int getWidth() const { return mWidth; }
+	int getHeight() const { return mHeight; }
+	TileType getData(int x, int y) const { return mData[toIndex(x, y, mWidth)]; }
+
+	TileSpan getRow(int y) const { return getView().getRow(y); }
+	MapView getView() const { return MapView(mData.data(), mWidth, mHeight); }
+
+	bool isValid() const { return mWidth > 0 && mHeight > 0; }
+
+	//width * height ĭ  ۿ   ִ.
+	static bool isValidSize(int width, int height)
+	{
+		return width > 0 && height > 0 &&
+			static_cast<std::size_t>(width) * static_cast<std::size_t>(height) <= TileBuffer().max_size();
+	}
+
+	//Ÿ ۸ directory  ޸  Ϸ ű.  ڿ̸ ٽ  ű.
+	// ų  ϸ ۸ ״ ΰ false ȯ.
+	bool setMappedStorage(const std::string& directory)
+	{
+		try
+		{
+			TileBuffer data(mData.begin(), mData.end(), MappedAllocator<TileType>(directory));
+			mData.swap(data);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	bool isMappedStorage() const { return mData.get_allocator().isMapped(); }
+
+	//  ʿ ó Ģ Ѵ.  Ҵڷ  ۸    ٲ۴.
+	bool applyPostProcess(const PostProcess& post)
+	{
+		try
+		{
+			TileBuffer data(mData.size(), TileType::Wall, mData.get_allocator());
+			post.apply(mData.data(), data.data(), mWidth, mHeight);
+			mData.swap(data);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+protected:
+	//ũⰡ   0 x 0 ȴ. Ҵڴ ״ Ѵ.
+	void resize(int width, int height)
+	{
+		if (!isValidSize(width, height))
+		{
+			width = 0;
+			height = 0;
+		}
+
+		mWidth = width;
+		mHeight = height;
+		mData.resize(static_cast<std::size_t>(mWidth) * mHeight, TileType::Wall);
+	}
+
+	int mWidth;
+	int mHeight;
+	TileBuffer mData;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace pmg
+{
+
+//  Բ  ޸ ѵ(Ʈ). 纻  ¸ ϹǷ
+//GeneratorPool ۾ڵ鿡  budget ѱ ÿ   ü ѵ ȴ.
+// ޸𸮸 ϴ  BSP̴. ٸ  setControl budget Ѱܵ  ʴ´.
+//BSP  Ҵ  ʰ Ÿ , , , , ӽ  ũ⸦ ؼ  ̴.
+class MemoryBudget
+{
+public:
+	//limit 0 ϸ   뷮 .
+	explicit MemoryBudget(std::int64_t limit = 0) : mState(std::make_shared<State>())
+	{
+		mState->mLimit.store(limit);
+	}
+
+	void setLimit(std::int64_t limit) { mState->mLimit.store(limit); }
+	std::int64_t getLimit() const { return mState->mLimit.load(); }
+
+	std::int64_t getUsed() const { return mState->mUsed.load(std::memory_order_relaxed); }
+	std::int64_t getPeak() const { return mState->mPeak.load(std::memory_order_relaxed); }
+	void resetPeak() { mState->mPeak.store(getUsed()); }
+
+	//ѵ Ѱ Ǹ  ʰ false.
+	//  ѵ   ٲ Ƿ ٸ 尡 ѵ  뷮 ̶  ʴ´.
+	bool charge(std::int64_t bytes)
+	{
+		std::int64_t limit = mState->mLimit.load(std::memory_order_relaxed);
+		std::int64_t used = mState->mUsed.load(std::memory_order_relaxed);
+
+		do
+		{
+			if (limit > 0 && used + bytes > limit)
+				return false;
+		} while (!mState->mUsed.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+		updateMax(mState->mPeak, used + bytes);
+
+		return true;
+	}
+
+	void release(std::int64_t bytes) { mState->mUsed.fetch_sub(bytes, std::memory_order_relaxed); }
+
+	static void updateMax(std::atomic<std::int64_t>& peak, std::int64_t value)
+	{
+		std::int64_t now = peak.load(std::memory_order_relaxed);
+
+		while (now < value && !peak.compare_exchange_weak(now, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+private:
+	struct State
+	{
+		std::atomic<std::int64_t> mLimit{ 0 };
+		std::atomic<std::int64_t> mUsed{ 0 };
+		std::atomic<std::int64_t> mPeak{ 0 };
+	};
+
+	std::shared_ptr<State> mState;
+};
+
+//    ޸. budget Բ ϸ鼭 ̹  뷮 ִ밪  .
+// ̶ ѵ  isExceeded true ´. Ҹ      budget ش.
+//   尡    ִ. ѵ budget Ȯϰ ⼭  縸 Ѵ.
+class MemoryScope
+{
+public:
+	explicit MemoryScope(const MemoryBudget& budget) : mBudget(budget), mUsed(0), mPeak(0), mIsExceeded(false) { }
+	MemoryScope(const MemoryScope&) = delete;
+	MemoryScope& operator=(const MemoryScope&) = delete;
+
+	~MemoryScope()
+	{
+		mBudget.release(mUsed.load());
+	}
+
+	bool charge(std::int64_t bytes)
+	{
+		if (!mBudget.charge(bytes))
+		{
+			mIsExceeded.store(true, std::memory_order_relaxed);
+			return false;
+		}
+
+		MemoryBudget::updateMax(mPeak, mUsed.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+		return true;
+	}
+
+	void release(std::int64_t bytes)
+	{
+		mUsed.fetch_sub(bytes, std::memory_order_relaxed);
+		mBudget.release(bytes);
+	}
+
+	std::int64_t getUsed() const { return mUsed.load(std::memory_order_relaxed); }
+	std::int64_t getPeak() const { return mPeak.load(std::memory_order_relaxed); }
+	bool isExceeded() const { return mIsExceeded.load(std::memory_order_relaxed); }
+
+private:
+	MemoryBudget mBudget;
+	std::atomic<std::int64_t> mUsed;
+	std::atomic<std::int64_t> mPeak;
+	std::atomic<bool> mIsExceeded;
+};
+
+//ũⰡ ٲ ӽ  . set  ũ⸦ ˷ָ ̸ scope ݿϰ Ҹ   ش.
+//scope nullptr̸ ƹ͵  ʴ´.
+class MemoryCharge
+{
+public:
+	explicit MemoryCharge(MemoryScope* scope) : mScope(scope), mBytes(0) { }
+	MemoryCharge(const MemoryCharge&) = delete;
+	MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+	~MemoryCharge() { set(0); }
+
+	//ѵ  false. ̶  ũ ´.
+	bool set(std::int64_t bytes)
+	{
+		if (mScope == nullptr || bytes == mBytes)
+			return true;
+
+		if (bytes > mBytes)
+		{
+			if (!mScope->charge(bytes - mBytes))
+				return false;
+		}
+		else
+		{
+			mScope->release(mBytes - bytes);
+		}
+
+		mBytes = bytes;
+
+		return true;
+	}
+
+private:
+	MemoryScope* mScope;
+	std::int64_t mBytes;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "pipeline.h"
+
+void pmg::Pipeline::addLayout(int splitNum, float splitRange, float sizeMid, float sizeRange, int complexity)
+{
+	mStages.push_back({ StageType::Layout, static_cast<int>(mLayouts.size()) });
+	mLayouts.push_back({ splitNum, splitRange, sizeMid, sizeRange, complexity });
+}
+
+void pmg::Pipeline::addRoomCave(int iteration, float initialWallRate, int wallCriterionNum)
+{
+	//ܰ   Ƿ Ÿ ۴  ʴ´.
+	mStages.push_back({ StageType::RoomCave, static_cast<int>(mCaves.size()) });
+	mCaves.emplace_back(0, 0, iteration, initialWallRate, wallCriterionNum);
+}
+
+void pmg::Pipeline::addRoomCave(const RuleSchedule& schedule, float initialWallRate)
+{
+	mStages.push_back({ StageType::RoomCave, static_cast<int>(mCaves.size()) });
+	mCaves.emplace_back(0, 0, 0, initialWallRate, 0);
+	mCaves.back().setRuleSchedule(schedule);
+}
+
+void pmg::Pipeline::addDoorTunnel(int energy, float rotateDelta, float digDelta)
+{
+	mStages.push_back({ StageType::DoorTunnel, static_cast<int>(mTunnels.size()) });
+	mTunnels.emplace_back(0, 0, 0, energy, rotateDelta, digDelta);
+}
+
+void pmg::Pipeline::reportStage(size_t stage, float rate) const
+{
+	mControl.report((stage + rate) / mStages.size());
+}
+
+pmg::Rectangle pmg::Pipeline::getInnerArea(const Room& room) const
+{
+	return Rectangle(room.mX + 1, room.mY + 1, room.mWidth - 2, room.mHeight - 2);
+}
+
+pmg::Point pmg::Pipeline::getDoorInside(const Point& door, const Room& room) const
+{
+	if (door.mY == room.mY)
+		return Point(door.mX, door.mY + 1);
+
+	if (door.mX == room.getRight())
+		return Point(door.mX - 1, door.mY);
+
+	if (door.mY == room.getBottom())
+		return Point(door.mX, door.mY - 1);
+
+	return Point(door.mX + 1, door.mY);
+}
+
+void pmg::Pipeline::openDoorInside(const Room& room)
+{
+	for (auto& door : room.mDoors)
+	{
+		Point inside = getDoorInside(door, room);
+
+		mData[toIndex(inside.mX, inside.mY, mWidth)] = TileType::Room;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+#include <random>
+#include <vector>
+#include "bsp.h"
+#include "agent.h"
+#include "cellularAutomata.h"
+#include "mapView.h"
+#include "trace.h"
+
+namespace pmg
+{
+
+//ϳ Ÿ ۸  ܰ谡 ʷ   ռ .
+//) BSP  ġ ->  ʸ 귯 丶Ÿ ȭ ->  Ʈ  ձ
+// ܰ ڱ  Ÿϸ ǵ帮  ü ũ ۸  ʴ´.
+class Pipeline : public TileMap
+{
+	enum class StageType
+	{
+		Layout,
+		RoomCave,
+		DoorTunnel
+	};
+
+	struct Stage
+	{
+		StageType mType;
+		int mIndex; //  迭 ġ
+	};
+
+	struct Layout
+	{
+		int mSplitNum;
+		float mSplitRange;
+		float mSizeMid;
+		float mSizeRange;
+		int mComplexity;
+	};
+
+public:
+	Pipeline(int width, int height)
+		: TileMap(width, height), mRoot(0, 0, width, height)
+	{
+	}
+
+	//BSP   ġѴ.  ܰ ⼭    Ѵ.
+	void addLayout(int splitNum, float splitRange, float sizeMid, float sizeRange, int complexity);
+
+	//  ׵θ ʸ 귯 丶Ÿ ٽ .  ٷ  ĭ ׻ д.
+	void addRoomCave(int iteration, float initialWallRate, int wallCriterionNum);
+	void addRoomCave(const RuleSchedule& schedule, float initialWallRate);
+
+	//     Ʈ ϳ ߽  ȿ  մ´.
+	void addDoorTunnel(int energy, float rotateDelta, float digDelta);
+
+	template<typename RandomGenerator = std::mt19937>
+	void createMap()
+	{
+		std::random_device rd;
+		createMap<RandomGenerator>(rd());
+	}
+
+	//Layout ܰ谡  ϳ  ߰ų setControl ѱ ū ҵǸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		PMG_TRACE_SCOPE("Pipeline::createMap");
+
+		if (!isValid())
+			return false;
+
+		RandomGenerator generator(seed);
+
+		std::fill(mData.begin(), mData.end(), TileType::Wall);
+		mRooms.clear();
+
+		for (size_t i = 0; i < mStages.size(); i++)
+		{
+			const Stage& stage = mStages[i];
+
+			if (mControl.isCancelled())
+				return false;
+
+			switch (stage.mType)
+			{
+			case StageType::Layout:
+			{
+				const Layout& layout = mLayouts[stage.mIndex];
+
+				mRoot.reset(0, 0, mWidth, mHeight);
+				mRoot.splitTree(layout.mSplitNum, layout.mSplitRange, generator, &mControl);
+				mRoot.makeRoom(layout.mSizeMid, layout.mSizeRange, generator);
+				mRoot.merge(layout.mComplexity, generator, &mControl);
+
+				if (mControl.isCancelled())
+					return false;
+
+				mRoot.fillData(mWidth, mHeight, mData.data());
+
+				mRooms.clear();
+				mRoot.getLeafRooms(mRooms);
+
+				if (mRooms.empty())
+					return false;
+
+				break;
+			}
+			case StageType::RoomCave:
+				for (size_t r = 0; r < mRooms.size(); r++)
+				{
+					if (mControl.isCancelled())
+						return false;
+
+					mCaves[stage.mIndex].fillArea(mData, mWidth, mHeight, getInnerArea(*mRooms[r]), generator);
+					openDoorInside(*mRooms[r]);
+					reportStage(i, static_cast<float>(r + 1) / mRooms.size());
+				}
+				break;
+			case StageType::DoorTunnel:
+			{
+				std::vector<Point> starts;
+				std::vector<Rectangle> areas;
+
+				for (auto room : mRooms)
+				{
+					for (auto& door : room->mDoors)
+					{
+						starts.push_back(getDoorInside(door, *room));
+						areas.push_back(getInnerArea(*room));
+					}
+				}
+
+				// ܰ θ ˸Ƿ Ʈ  ū ѱ.
+				Agent& tunnel = mTunnels[stage.mIndex];
+
+				tunnel.setControl(GenerationControl(mControl.getToken()));
+
+				if (!tunnel.dig(mData, mWidth, starts, areas, generator))
+					return false;
+
+				break;
+			}
+			}
+
+			reportStage(i, 1.0f);
+		}
+
+		return true;
+	}
+
+	//ܰ ̿  ̿ Ȯϴ  ū,  ܰ    ݹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+	// Layout ܰ迡  .
+	const std::vector<Room*>& getRooms() const { return mRooms; }
+
+private:
+	//stage ܰ踦 rateŭ   ü  ˸.
+	void reportStage(size_t stage, float rate) const;
+
+	Rectangle getInnerArea(const Room& room) const;
+	Point getDoorInside(const Point& door, const Room& room) const;
+	void openDoorInside(const Room& room);
+
+	std::vector<Stage> mStages;
+	std::vector<Layout> mLayouts;
+	std::vector<CellularAutomata> mCaves;
+	std::vector<Agent> mTunnels;
+
+	Leaf mRoot;
+	std::vector<Room*> mRooms;
+	GenerationControl mControl;
+};
+
+}
\ No newline at end of file
@@ -1,35 +1,48 @@
 #pragma once
-#include <type_traits>
 #include <fstream>
+#include <string>
 
 #include "bsp.h"
 #include "agent.h"
+#include "agentSwarm.h"
+#include "roomScatter.h"
 #include "cellularAutomata.h"
+#include "async.h"
+#include "pipeline.h"
+#include "dungeon.h"
+#include "mapView.h"
+#include "serialize.h"
+#include "image.h"
+#include "mapCache.h"
+#include "generatorPool.h"
+#include "postProcess.h"
 
 namespace pmg
 {
+//getView() ϴ ⳪ MapView  ྿ ؽƮ Ѵ.
 template<typename Generator>
 void toTextFile(const Generator& generator,
 	const std::string& path, std::function<char(TileType)> outputFunc)
 {
-	static_assert(std::is_same<Generator, BSP>::value ||
-				  std::is_same<Generator, Agent>::value ||
-				  std::is_same<Generator, CellularAutomata>::value,
-		"Generator must be BSP or Agent or CellularAutomata");
+	const MapView& view = generator.getView();
 
 	std::ofstream stream(path);
 
 	if (!stream.is_open())
 		return;
 
-	for (int y = 0; y < generator.getHeight(); y++)
+	std::string line;
+
+	for (int y = 0; y < view.getHeight(); y++)
 	{
-		for (int x = 0; x < generator.getWidth(); x++)
+		line.clear();
+
+		for (auto tile : view.getRow(y))
 		{
-			stream << outputFunc(generator.getData(x, y));
+			line.push_back(outputFunc(tile));
 		}
 
-		stream << std::endl;
+		stream << line << std::endl;
 	}
 
 	stream.close();
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <future>
+#include "postProcess.h"
+
+static bool isFloor(pmg::TileType tile)
+{
+	return tile != pmg::TileType::Wall;
+}
+
+//    Ÿ.  ̸ ,  ۿ .
+static pmg::TileType getOpenTile(pmg::TileType beside)
+{
+	return beside == pmg::TileType::Hall ? pmg::TileType::Hall : pmg::TileType::Room;
+}
+
+pmg::TileType pmg::CleanupRule::removePillar(const Neighbours& cell)
+{
+	if (cell.getCenter() != TileType::Wall || cell.mOutsideMask != 0)
+		return cell.getCenter();
+
+	for (int i = 0; i < 9; i++)
+	{
+		if (i != 4 && !isFloor(cell.mTiles[i]))
+			return cell.getCenter();
+	}
+
+	return getOpenTile(cell.get(0, -1));
+}
+
+pmg::TileType pmg::CleanupRule::solidBorder(const Neighbours& cell)
+{
+	return cell.mOutsideMask != 0 ? TileType::Wall : cell.getCenter();
+}
+
+pmg::TileType pmg::CleanupRule::widenChoke(const Neighbours& cell)
+{
+	if (cell.getCenter() != TileType::Wall || cell.mOutsideMask != 0)
+		return cell.getCenter();
+
+	// ̿ ϳ  ̿ ϳ   ְ    밢 ĭ ̸
+	// ĭ  ĭ ؼ ¿ ̾  ִ.
+	for (int dx = -1; dx <= 1; dx += 2)
+	{
+		for (int dy = -1; dy <= 1; dy += 2)
+		{
+			if (isFloor(cell.get(dx, 0)) && isFloor(cell.get(0, dy)) && !isFloor(cell.get(dx, dy)))
+				return getOpenTile(cell.get(dx, 0));
+		}
+	}
+
+	return cell.getCenter();
+}
+
+pmg::TileType pmg::CleanupRule::markDoor(const Neighbours& cell)
+{
+	if (cell.getCenter() != TileType::Room)
+		return cell.getCenter();
+
+	if (cell.get(-1, 0) == TileType::Hall || cell.get(1, 0) == TileType::Hall ||
+		cell.get(0, -1) == TileType::Hall || cell.get(0, 1) == TileType::Hall)
+	{
+		return TileType::Door;
+	}
+
+	return cell.getCenter();
+}
+
+void pmg::PostProcess::apply(const TileType* src, TileType* dst, int width, int height) const
+{
+	if (width <= 0 || height <= 0)
+		return;
+
+	if (mRules.empty())
+	{
+		std::copy(src, src + toIndex(0, height, width), dst);
+		return;
+	}
+
+	int blockRowNum = (height + mBlockSize - 1) / mBlockSize;
+	int blockColNum = (width + mBlockSize - 1) / mBlockSize;
+	int chunkNum = std::max(1, std::min(mThreadNum, blockRowNum));
+	int chunkRows = (blockRowNum + chunkNum - 1) / chunkNum;
+
+	//ϳ src а dst  ٸ ĭ Ƿ    .
+	auto work = [this, src, dst, width, height, blockColNum](int begin, int end)
+	{
+		std::vector<TileType> frames[2];
+
+		for (int by = begin; by < end; by++)
+		{
+			for (int bx = 0; bx < blockColNum; bx++)
+			{
+				applyBlock(src, dst, width, height, bx * mBlockSize, by * mBlockSize, frames);
+			}
+		}
+	};
+
+	std::vector<std::future<void>> tasks;
+
+	for (int begin = chunkRows; begin < blockRowNum; begin += chunkRows)
+	{
+		tasks.push_back(std::async(std::launch::async, work, begin, std::min(blockRowNum, begin + chunkRows)));
+	}
+
+	work(0, std::min(blockRowNum, chunkRows));
+
+	for (auto& task : tasks)
+	{
+		task.get();
+	}
+}
+
+void pmg::PostProcess::applyBlock(const TileType* src, TileType* dst, int width, int height, int left, int top,
+	std::vector<TileType>* frames) const
+{
+	//i° Ģ   (Ģ  - i - 1)ĭ   ʿϴ.
+	int halo = static_cast<int>(mRules.size());
+	int blockWidth = std::min(mBlockSize, width - left);
+	int blockHeight = std::min(mBlockSize, height - top);
+	int frameLeft = left - halo;
+	int frameTop = top - halo;
+	int frameWidth = blockWidth + halo * 2;
+	int frameHeight = blockHeight + halo * 2;
+
+	frames[0].resize(static_cast<std::size_t>(frameWidth) * frameHeight);
+	frames[1].resize(static_cast<std::size_t>(frameWidth) * frameHeight);
+
+	TileType* now = frames[0].data();
+	TileType* next = frames[1].data();
+
+	int copyLeft = std::max(0, frameLeft);
+	int copyRight = std::min(width, frameLeft + frameWidth);
+
+	for (int y = std::max(0, frameTop); y < std::min(height, frameTop + frameHeight); y++)
+	{
+		std::copy(src + toIndex(copyLeft, y, width), src + toIndex(copyRight, y, width),
+			now + toIndex(copyLeft - frameLeft, y - frameTop, frameWidth));
+	}
+
+	for (int r = 0; r < halo; r++)
+	{
+		PostRule rule = mRules[r];
+		int grow = halo - r - 1;
+		int areaLeft = std::max(0, left - grow);
+		int areaRight = std::min(width, left + blockWidth + grow);
+		int areaTop = std::max(0, top - grow);
+		int areaBottom = std::min(height, top + blockHeight + grow);
+
+		for (int y = areaTop; y < areaBottom; y++)
+		{
+			bool isEdgeRow = y == 0 || y == height - 1;
+			const TileType* row = now + toIndex(0, y - frameTop, frameWidth) - frameLeft;
+			TileType* out = next + toIndex(0, y - frameTop, frameWidth) - frameLeft;
+
+			for (int x = areaLeft; x < areaRight; x++)
+			{
+				Neighbours cell;
+				cell.mOutsideMask = 0;
+
+				if (!isEdgeRow && x > 0 && x < width - 1)
+				{
+					for (int dy = -1; dy <= 1; dy++)
+					{
+						const TileType* p = row + dy * frameWidth + x;
+
+						cell.mTiles[(dy + 1) * 3] = p[-1];
+						cell.mTiles[(dy + 1) * 3 + 1] = p[0];
+						cell.mTiles[(dy + 1) * 3 + 2] = p[1];
+					}
+				}
+				else
+				{
+					for (int dy = -1; dy <= 1; dy++)
+					{
+						for (int dx = -1; dx <= 1; dx++)
+						{
+							int idx = (dy + 1) * 3 + dx + 1;
+
+							if (x + dx < 0 || x + dx >= width || y + dy < 0 || y + dy >= height)
+							{
+								cell.mTiles[idx] = TileType::Wall;
+								cell.mOutsideMask |= 1 << idx;
+							}
+							else
+							{
+								cell.mTiles[idx] = row[dy * frameWidth + x + dx];
+							}
+						}
+					}
+				}
+
+				out[x] = rule(cell);
+			}
+		}
+
+		std::swap(now, next);
+	}
+
+	for (int y = top; y < top + blockHeight; y++)
+	{
+		const TileType* row = now + toIndex(left - frameLeft, y - frameTop, frameWidth);
+
+		std::copy(row, row + blockWidth, dst + toIndex(left, y, width));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include "types.h"
+
+namespace pmg
+{
+
+//(x, y)  ϴ 3x3 ĭ.   ĭ Wall а mOutsideMask  ġ Ʈ Ҵ.
+struct Neighbours
+{
+	TileType get(int dx, int dy) const { return mTiles[(dy + 1) * 3 + dx + 1]; }
+	bool isOutside(int dx, int dy) const { return ((mOutsideMask >> ((dy + 1) * 3 + dx + 1)) & 1) != 0; }
+	TileType getCenter() const { return mTiles[4]; }
+
+	TileType mTiles[9]; // 켱,  4
+	int mOutsideMask;
+};
+
+//3x3 ̿   ĭ  Ÿ ϴ ó Ģ.
+typedef TileType(*PostRule)(const Neighbours& cell);
+
+//   ϴ  Ģ.
+namespace CleanupRule
+{
+	//8    ִ ĭ ܵ   ش.  ĭ  , ƴϸ  ȴ.
+	TileType removePillar(const Neighbours& cell);
+
+	// ڸ ĭ   .
+	TileType solidBorder(const Neighbours& cell);
+
+	//밢θ  ִ  ĭ   . ¿θ ̸     ĭ  .
+	TileType widenChoke(const Neighbours& cell);
+
+	// ¿ ´  ĭ  ٲ۴.
+	TileType markDoor(const Neighbours& cell);
+}
+
+// 3x3 Ģ   ü    Ͱ     ȸ .
+// blockSize ũ  , ϸ Ģ ŭ   ۾ ۿ ÷  Ģ ޾ Ѵ.
+//Ģ  ü ٽ  Ƿ Ģ   ĳ ȿ .
+class PostProcess
+{
+public:
+	PostProcess() : mBlockSize(64), mThreadNum(1) { }
+
+	void addRule(PostRule rule) { mRules.push_back(rule); }
+	const std::vector<PostRule>& getRules() const { return mRules; }
+
+	void setBlockSize(int blockSize) { mBlockSize = blockSize < 8 ? 8 : blockSize; }
+
+	//  threadNum   ķ óѴ.     .
+	void setThreadNum(int threadNum = static_cast<int>(std::thread::hardware_concurrency()))
+	{
+		mThreadNum = threadNum < 1 ? 1 : threadNum;
+	}
+
+	//src о dst .  ۴ ġ  ȴ.
+	void apply(const TileType* src, TileType* dst, int width, int height) const;
+
+private:
+	//(left, top) ϴ  ϳ. frames ۾   .
+	void applyBlock(const TileType* src, TileType* dst, int width, int height, int left, int top,
+		std::vector<TileType>* frames) const;
+
+	std::vector<PostRule> mRules;
+	int mBlockSize;
+	int mThreadNum;
+};
+
+}
\ No newline at end of file
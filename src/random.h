@@ -0,0 +1,167 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace pmg
+{
+
+//ī  64Ʈ  . ° 8Ʈ Ʈ/ûũ ϳ  ٴϱ .
+class SplitMix64
+{
+public:
+	typedef std::uint64_t result_type;
+
+	explicit SplitMix64(std::uint64_t seed = 0) : mState(seed) { }
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()()
+	{
+		return mix(mState += 0x9E3779B97F4A7C15ull);
+	}
+
+	static std::uint64_t mix(std::uint64_t z)
+	{
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+private:
+	std::uint64_t mState;
+};
+
+//xoshiro256**. 32Ʈ · std::mt19937 ξ  .
+// õ忡 stream(index)   Ʈ   ִ.
+class Xoshiro256
+{
+public:
+	typedef std::uint64_t result_type;
+
+	explicit Xoshiro256(std::uint64_t seed = 0) : mSeed(seed)
+	{
+		SplitMix64 init(seed);
+
+		for (int i = 0; i < 4; i++)
+		{
+			mState[i] = init();
+		}
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()()
+	{
+		std::uint64_t res = rotl(mState[1] * 5, 7) * 9;
+		std::uint64_t t = mState[1] << 17;
+
+		mState[2] ^= mState[0];
+		mState[3] ^= mState[1];
+		mState[1] ^= mState[2];
+		mState[0] ^= mState[3];
+		mState[2] ^= t;
+		mState[3] = rotl(mState[3], 45);
+
+		return res;
+	}
+
+	// Ʈ probability / 256 Ȯ 1 64Ʈ ũ. Ȯ Ʈ ŭ Ƿ ִ 8 ȣ 64ĭ ä.
+	std::uint64_t nextMask(int probability)
+	{
+		if (probability <= 0)
+			return 0;
+
+		if (probability >= 256)
+			return ~0ull;
+
+		//Ʒ Ʈ 1̸ OR, 0̸ AND ġ  Ȯ 0.b7b6...b0  ȴ.
+		int shift = 0;
+		while (((probability >> shift) & 1) == 0)
+			shift++;
+
+		std::uint64_t mask = (*this)();
+
+		for (int i = shift + 1; i < 8; i++)
+		{
+			if ((probability >> i) & 1)
+				mask |= (*this)();
+			else
+				mask &= (*this)();
+		}
+
+		return mask;
+	}
+
+	//õ indexκ   Ʈ. ȣ      index  Ʈ ȴ.
+	Xoshiro256 stream(std::uint64_t index) const
+	{
+		return Xoshiro256(SplitMix64::mix(mSeed ^ SplitMix64::mix(index + 0x9E3779B97F4A7C15ull)));
+	}
+
+private:
+	static std::uint64_t rotl(std::uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	std::uint64_t mSeed;
+	std::uint64_t mState[4];
+};
+
+//Ⱑ  ΰ . ⺻  Ʈ   ʰ  ⸦ Ѵ.
+template<typename RandomGenerator>
+struct RandomTraits
+{
+	static const bool IS_BULK = false;
+
+	class Stream
+	{
+	public:
+		typedef typename RandomGenerator::result_type result_type;
+
+		explicit Stream(RandomGenerator& generator) : mGenerator(&generator) { }
+
+		static constexpr result_type min() { return RandomGenerator::min(); }
+		static constexpr result_type max() { return RandomGenerator::max(); }
+
+		result_type operator()() { return (*mGenerator)(); }
+
+	private:
+		RandomGenerator* mGenerator;
+	};
+
+	static Stream makeStream(RandomGenerator& generator, std::uint64_t)
+	{
+		return Stream(generator);
+	}
+};
+
+template<>
+struct RandomTraits<Xoshiro256>
+{
+	static const bool IS_BULK = true;
+
+	typedef Xoshiro256 Stream;
+
+	static Stream makeStream(Xoshiro256& generator, std::uint64_t index)
+	{
+		return generator.stream(index);
+	}
+};
+
+//ĳ Űó μ Ϸ ٲ ƾ ϴ    ̸.
+//typeid ̸  ٸǷ  Ѵ. ٸ ⸦  ƯȭѴ.
+template<typename RandomGenerator>
+struct RandomTag;
+
+template<> struct RandomTag<std::mt19937> { static const char* get() { return "mt19937"; } };
+template<> struct RandomTag<std::mt19937_64> { static const char* get() { return "mt19937_64"; } };
+template<> struct RandomTag<std::minstd_rand> { static const char* get() { return "minstd_rand"; } };
+template<> struct RandomTag<std::minstd_rand0> { static const char* get() { return "minstd_rand0"; } };
+template<> struct RandomTag<SplitMix64> { static const char* get() { return "SplitMix64"; } };
+template<> struct RandomTag<Xoshiro256> { static const char* get() { return "Xoshiro256"; } };
+
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "roomScatter.h"
+
+//begin    end ĭ visit(x, y, η ̴,  ) θ.
+template<typename Visit>
+static void walkPath(const pmg::Point& begin, const pmg::Point& end, bool isHorizontalFirst, Visit visit)
+{
+	pmg::Point bend = isHorizontalFirst ? pmg::Point(end.mX, begin.mY) : pmg::Point(begin.mX, end.mY);
+	int stepX = bend.mX > begin.mX ? 1 : -1;
+	int stepY = bend.mY > begin.mY ? 1 : -1;
+
+	for (int x = begin.mX, y = begin.mY; x != bend.mX || y != bend.mY;)
+	{
+		visit(x, y, isHorizontalFirst, false);
+
+		if (isHorizontalFirst)
+			x += stepX;
+		else
+			y += stepY;
+	}
+
+	visit(bend.mX, bend.mY, isHorizontalFirst, bend != begin && bend != end);
+
+	stepX = end.mX > bend.mX ? 1 : -1;
+	stepY = end.mY > bend.mY ? 1 : -1;
+
+	for (int x = bend.mX, y = bend.mY; x != end.mX || y != end.mY;)
+	{
+		if (isHorizontalFirst)
+			y += stepY;
+		else
+			x += stepX;
+
+		visit(x, y, !isHorizontalFirst, false);
+	}
+}
+
+void pmg::RoomScatter::resetGrid()
+{
+	mParentRooms.clear();
+	mCellNexts.clear();
+
+	mCellSize = mRoomSizeMax + mRoomGap;
+	mCellWidth = mWidth / mCellSize + 1;
+	mCellHeight = mHeight / mCellSize + 1;
+	mCellHeads.assign(static_cast<std::size_t>(mCellWidth) * mCellHeight, -1);
+}
+
+bool pmg::RoomScatter::isFree(const Room& room) const
+{
+	if (room.mX < 0 || room.mY < 0 || room.getRight() >= mWidth || room.getBottom() >= mHeight)
+		return false;
+
+	int cellX = room.mX / mCellSize;
+	int cellY = room.mY / mCellSize;
+
+	for (int y = std::max(0, cellY - 1); y <= std::min(mCellHeight - 1, cellY + 1); y++)
+	{
+		for (int x = std::max(0, cellX - 1); x <= std::min(mCellWidth - 1, cellX + 1); x++)
+		{
+			for (int i = mCellHeads[toIndex(x, y, mCellWidth)]; i != -1; i = mCellNexts[i])
+			{
+				const Room& other = mRooms[i];
+
+				if (room.mX < other.mX + other.mWidth + mRoomGap && other.mX < room.mX + room.mWidth + mRoomGap &&
+					room.mY < other.mY + other.mHeight + mRoomGap && other.mY < room.mY + room.mHeight + mRoomGap)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void pmg::RoomScatter::addRoom(const Room& room, int parent)
+{
+	std::size_t cell = toIndex(room.mX / mCellSize, room.mY / mCellSize, mCellWidth);
+
+	mRooms.push_back(room);
+	mParentRooms.push_back(parent);
+	mCellNexts.push_back(mCellHeads[cell]);
+	mCellHeads[cell] = static_cast<int>(mRooms.size()) - 1;
+}
+
+int pmg::RoomScatter::findRoom(int x, int y) const
+{
+	//(x, y) ϴ    ĭ (x, y) roomSizeMaxĭ ̹Ƿ    ĭ  ȴ.
+	int cellX = x / mCellSize;
+	int cellY = y / mCellSize;
+	Point pos(x, y);
+
+	for (int cy = std::max(0, cellY - 1); cy <= cellY; cy++)
+	{
+		for (int cx = std::max(0, cellX - 1); cx <= cellX; cx++)
+		{
+			for (int i = mCellHeads[toIndex(cx, cy, mCellWidth)]; i != -1; i = mCellNexts[i])
+			{
+				if (mRooms[i].isContain(pos))
+					return i;
+			}
+		}
+	}
+
+	return -1;
+}
+
+void pmg::RoomScatter::collectEdges(OUT std::vector<Edge>& edges) const
+{
+	//θ  ߽ɰ Ÿ ݿø 2 * minDist + 2  ʴ´.  Ÿ  波  .
+	//߽ ǥ   ٷǷ Ÿ  .
+	std::int64_t linkDist = static_cast<std::int64_t>(std::ceil(getMinDist() * 2.0f)) + 2;
+	std::int64_t maxLength = linkDist * linkDist * 4;
+	int reach = static_cast<int>(linkDist + mRoomSizeMax) / mCellSize + 1;
+
+	auto getLength = [this](int from, int to)
+	{
+		const Room& a = mRooms[from];
+		const Room& b = mRooms[to];
+		std::int64_t dx = (a.mX * 2 + a.mWidth) - (b.mX * 2 + b.mWidth);
+		std::int64_t dy = (a.mY * 2 + a.mHeight) - (b.mY * 2 + b.mHeight);
+
+		return dx * dx + dy * dy;
+	};
+
+	for (int i = 0; i < static_cast<int>(mRooms.size()); i++)
+	{
+		int cellX = mRooms[i].mX / mCellSize;
+		int cellY = mRooms[i].mY / mCellSize;
+
+		for (int y = std::max(0, cellY - reach); y <= std::min(mCellHeight - 1, cellY + reach); y++)
+		{
+			for (int x = std::max(0, cellX - reach); x <= std::min(mCellWidth - 1, cellX + reach); x++)
+			{
+				for (int j = mCellHeads[toIndex(x, y, mCellWidth)]; j != -1; j = mCellNexts[j])
+				{
+					if (j <= i)
+						continue;
+
+					std::int64_t length = getLength(i, j);
+
+					if (length <= maxLength)
+						edges.push_back({ i, j, length });
+				}
+			}
+		}
+
+		int parent = mParentRooms[i];
+
+		if (parent >= 0)
+			edges.push_back({ std::min(i, parent), std::max(i, parent), getLength(i, parent) });
+	}
+}
+
+int pmg::RoomScatter::getCrossCost(const Point& begin, const Point& end, bool isHorizontalFirst, int from, int to) const
+{
+	int cost = 0;
+
+	walkPath(begin, end, isHorizontalFirst, [&](int x, int y, bool, bool)
+	{
+		if (mRooms[from].isContain({ x, y }) || mRooms[to].isContain({ x, y }))
+			return;
+
+		if (findRoom(x, y) >= 0)
+			cost++;
+	});
+
+	return cost;
+}
+
+void pmg::RoomScatter::carveHallway(const Point& begin, const Point& end, bool isHorizontalFirst)
+{
+	walkPath(begin, end, isHorizontalFirst, [&](int x, int y, bool isHorizontal, bool isBend)
+	{
+		TileType& tile = mData[toIndex(x, y, mWidth)];
+
+		if (tile != TileType::Wall)
+			return;
+
+		int roomIdx = findRoom(x, y);
+
+		if (roomIdx >= 0)
+		{
+			Room& room = mRooms[roomIdx];
+			bool isSideX = x == room.mX || x == room.getRight();
+			bool isSideY = y == room.mY || y == room.getBottom();
+
+			//𼭸 ƴ ׵θ   . ׵θ 󰡰ų ̸  ͼ  .
+			if (!isBend && isSideX != isSideY && isSideX == isHorizontal)
+			{
+				tile = TileType::Door;
+				room.addDoor({ x, y });
+				return;
+			}
+		}
+
+		tile = TileType::Hall;
+		mHallways.emplace_back(x, y);
+	});
+}
+
+std::int64_t pmg::RoomScatter::getRoomInnerArea() const
+{
+	std::int64_t res = 0;
+
+	for (auto& room : mRooms)
+	{
+		res += static_cast<std::int64_t>(room.mWidth - 2) * (room.mHeight - 2);
+	}
+
+	return res;
+}
\ No newline at end of file
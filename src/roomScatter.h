@@ -0,0 +1,362 @@
+#pragma once
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "types.h"
+#include "bsp.h"
+#include "validator.h"
+#include "control.h"
+#include "mapView.h"
+#include "trace.h"
+#include "hash.h"
+
+namespace pmg
+{
+
+// Poisson-disc  Ѹ  波 ּ  Ʈ     Ǵ.
+//BSPó Ʈ ̿    ʰ,  ã ̿ ã⸦  ؽ÷ ϹǷ    ϴ ð .
+// Ÿ BSP  Room, TileType .
+class RoomScatter : public TileMap
+{
+	//  ߽  . ̴ ߽ ǥ     Ÿ .
+	struct Edge
+	{
+		int mFrom;
+		int mTo;
+		std::int64_t mLength;
+	};
+
+public:
+	//roomSizeMin ~ roomSizeMax ׵θ      . 波 roomGapĭ ̻ .
+	//extraEdgeRate Ʈ   ̿  ߰  Ȯ,  ȯ ΰ .
+	RoomScatter(int width, int height, int roomSizeMin, int roomSizeMax, int roomGap, float extraEdgeRate)
+		: TileMap(width, height),
+		mRoomSizeMin(std::max(3, roomSizeMin)), mRoomSizeMax(std::max(mRoomSizeMin, roomSizeMax)),
+		mRoomGap(std::max(1, roomGap)), mExtraEdgeRate(extraEdgeRate)
+	{
+	}
+
+	// ϰ    .      Ű ʰ Ѵ.
+	RoomScatter(const RoomScatter& other)
+		: TileMap(other.mWidth, other.mHeight),
+		mRoomSizeMin(other.mRoomSizeMin), mRoomSizeMax(other.mRoomSizeMax),
+		mRoomGap(other.mRoomGap), mExtraEdgeRate(other.mExtraEdgeRate), mRoomNumMax(other.mRoomNumMax),
+		mControl(other.mControl)
+	{
+	}
+
+	template<typename RandomGenerator = std::mt19937>
+	void createMap()
+	{
+		std::random_device rd;
+		createMap<RandomGenerator>(rd());
+	}
+
+	//setControl ѱ ū ҵǰų  ϳ  ϸ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed)
+	{
+		return generate<RandomGenerator>(seed, nullptr);
+	}
+
+	//constraint  ϴ  Ȯ ߰ ߰ false ȯ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createMap(unsigned int seed, const MapConstraint& constraint)
+	{
+		return generate<RandomGenerator>(seed, &constraint);
+	}
+
+	//õ带 ٲ㰡 constraint ϴ    ִ tryNum õѴ.
+	template<typename RandomGenerator = std::mt19937>
+	bool createValidMap(const MapConstraint& constraint, int tryNum)
+	{
+		std::random_device rd;
+
+		for (int i = 0; i < tryNum; i++)
+		{
+			if (createMap<RandomGenerator>(rd(), constraint))
+				return true;
+		}
+
+		return false;
+	}
+
+	//  . 0̸ ʿ     ´.
+	void setRoomNumMax(int roomNumMax) { mRoomNumMax = std::max(0, roomNumMax); }
+
+	//    ĭ.  ٸ  ׵θ   ĭ   ȴ.
+	const std::vector<Room>& getRooms() const { return mRooms; }
+	const std::vector<Point>& getHallways() const { return mHallways; }
+
+	//      Ȯϴ  ū ܰ躰  ݹ.
+	void setControl(const GenerationControl& control) { mControl = control; }
+	bool isCancelled() const { return mControl.isCancelled(); }
+
+	//createMap  ϴ  ؽ.
+	std::uint64_t getParamHash() const
+	{
+		Fnv1a hash;
+
+		hash.addString("RoomScatter");
+		hash.add(mWidth);
+		hash.add(mHeight);
+		hash.add(mRoomSizeMin);
+		hash.add(mRoomSizeMax);
+		hash.add(mRoomGap);
+		hash.add(mExtraEdgeRate);
+		hash.add(mRoomNumMax);
+
+		return hash.get();
+	}
+
+private:
+	template<typename RandomGenerator>
+	bool generate(unsigned int seed, const MapConstraint* constraint)
+	{
+		PMG_TRACE_SCOPE("RoomScatter::createMap");
+
+		if (!isValid())
+			return false;
+
+		RandomGenerator generator(seed);
+
+		std::fill(mData.begin(), mData.end(), TileType::Wall);
+		mRooms.clear();
+		mHallways.clear();
+
+		if (!placeRooms(generator))
+			return false;
+
+		mControl.report(0.3f);
+
+		if (constraint != nullptr && static_cast<int>(mRooms.size()) < constraint->mMinRoomNum)
+			return false;
+
+		//  ׻   Ƿ    ִ  ɷ  ִ.
+		if (constraint != nullptr && getRoomInnerArea() > constraint->mMaxWalkableRate * mWidth * mHeight)
+			return false;
+
+		for (auto& room : mRooms)
+		{
+			room.fillData(mWidth, mHeight, mData.data());
+		}
+
+		if (!connectRooms(generator))
+			return false;
+
+		mControl.report(1.0f);
+
+		return constraint == nullptr || constraint->isSatisfied(computeStats(getView()));
+	}
+
+	//Bridson .  ֺ   ϳ  ߽ɿ [minDist, 2 * minDist] Ÿ   TRY_NUM  ,
+	//ϳ     ĺ . ħ  ؽ 3x3 ĭ  ȴ.
+	template<typename RandomGenerator>
+	bool placeRooms(RandomGenerator& generator)
+	{
+		PMG_TRACE_SCOPE("RoomScatter::placeRooms");
+
+		resetGrid();
+
+		std::uniform_int_distribution<int> sizeDist(mRoomSizeMin, mRoomSizeMax);
+		std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+		float minDist = getMinDist();
+		std::vector<int> actives;
+
+		for (int t = 0; t < TRY_NUM && mRooms.empty(); t++)
+		{
+			int width = sizeDist(generator);
+			int height = sizeDist(generator);
+
+			if (width > mWidth || height > mHeight)
+				continue;
+
+			std::uniform_int_distribution<int> xDist(0, mWidth - width);
+			std::uniform_int_distribution<int> yDist(0, mHeight - height);
+			int x = xDist(generator);
+			int y = yDist(generator);
+
+			addRoom(Room(x, y, width, height), -1);
+		}
+
+		if (mRooms.empty())
+			return false;
+
+		actives.push_back(0);
+
+		while (!actives.empty())
+		{
+			if (mControl.isCancelled())
+				return false;
+
+			if (mRoomNumMax > 0 && static_cast<int>(mRooms.size()) >= mRoomNumMax)
+				break;
+
+			std::uniform_int_distribution<int> activeDist(0, static_cast<int>(actives.size()) - 1);
+			int pick = activeDist(generator);
+			int parent = actives[pick];
+			float centerX = mRooms[parent].mX + mRooms[parent].mWidth * 0.5f;
+			float centerY = mRooms[parent].mY + mRooms[parent].mHeight * 0.5f;
+			bool isPlaced = false;
+
+			for (int t = 0; t < TRY_NUM && !isPlaced; t++)
+			{
+				float angle = unitDist(generator) * 6.2831853f;
+				float dist = minDist * (1.0f + unitDist(generator));
+				int width = sizeDist(generator);
+				int height = sizeDist(generator);
+				int x = static_cast<int>(std::floor(centerX + std::cos(angle) * dist - width * 0.5f));
+				int y = static_cast<int>(std::floor(centerY + std::sin(angle) * dist - height * 0.5f));
+				Room room(x, y, width, height);
+
+				if (isFree(room))
+				{
+					addRoom(room, parent);
+					actives.push_back(static_cast<int>(mRooms.size()) - 1);
+					isPlaced = true;
+				}
+			}
+
+			if (!isPlaced)
+			{
+				actives[pick] = actives.back();
+				actives.pop_back();
+			}
+		}
+
+		PMG_TRACE_COUNT("scatter.room", mRooms.size());
+
+		return true;
+	}
+
+	//̿  ּ  Ʈ  Ʈ  extraEdgeRate Ȯ     Ǵ.
+	//渶 ڱ⸦  θ   Ƿ   ׻ ̾.
+	template<typename RandomGenerator>
+	bool connectRooms(RandomGenerator& generator)
+	{
+		PMG_TRACE_SCOPE("RoomScatter::connectRooms");
+
+		std::vector<Edge> edges;
+		collectEdges(edges);
+
+		std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs)
+		{
+			if (lhs.mLength != rhs.mLength)
+				return lhs.mLength < rhs.mLength;
+
+			if (lhs.mFrom != rhs.mFrom)
+				return lhs.mFrom < rhs.mFrom;
+
+			return lhs.mTo < rhs.mTo;
+		});
+
+		mControl.report(0.5f);
+
+		std::vector<int> groups(mRooms.size());
+
+		for (std::size_t i = 0; i < groups.size(); i++)
+		{
+			groups[i] = static_cast<int>(i);
+		}
+
+		std::uniform_real_distribution<float> extraDist(0.0f, 1.0f);
+		std::uniform_int_distribution<int> bendDist(0, 1);
+
+		for (std::size_t i = 0; i < edges.size(); i++)
+		{
+			if (mControl.isCancelled())
+				return false;
+
+			const Edge& edge = edges[i];
+
+			//θ  ߺ    ִ.
+			if (i > 0 && edge.mFrom == edges[i - 1].mFrom && edge.mTo == edges[i - 1].mTo)
+				continue;
+
+			int from = findGroup(groups, edge.mFrom);
+			int to = findGroup(groups, edge.mTo);
+
+			if (from != to)
+			{
+				groups[from] = to;
+			}
+			else if (mExtraEdgeRate <= 0.0f || extraDist(generator) >= mExtraEdgeRate)
+			{
+				continue;
+			}
+
+			Point begin = getCenter(mRooms[edge.mFrom]);
+			Point end = getCenter(mRooms[edge.mTo]);
+
+			//ٸ     ´.
+			int horizontalCost = getCrossCost(begin, end, true, edge.mFrom, edge.mTo);
+			int verticalCost = getCrossCost(begin, end, false, edge.mFrom, edge.mTo);
+			bool isHorizontalFirst = horizontalCost != verticalCost ? horizontalCost < verticalCost : bendDist(generator) == 0;
+
+			carveHallway(begin, end, isHorizontalFirst);
+
+			mRooms[edge.mFrom].mConnectedRooms.push_back(&mRooms[edge.mTo]);
+			mRooms[edge.mTo].mConnectedRooms.push_back(&mRooms[edge.mFrom]);
+		}
+
+		return true;
+	}
+
+	static int findGroup(std::vector<int>& groups, int idx)
+	{
+		while (groups[idx] != idx)
+		{
+			groups[idx] = groups[groups[idx]];
+			idx = groups[idx];
+		}
+
+		return idx;
+	}
+
+	//  ߽ θ  ߽ɿ  ּ Ÿ.
+	float getMinDist() const { return (mRoomSizeMin + mRoomSizeMax) * 0.5f + mRoomGap; }
+
+	static Point getCenter(const Room& room) { return Point(room.mX + room.mWidth / 2, room.mY + room.mHeight / 2); }
+
+	void resetGrid();
+	bool isFree(const Room& room) const;
+	void addRoom(const Room& room, int parent);
+
+	//(x, y) ׵θ ʿ ϴ  ȣ.  -1.
+	int findRoom(int x, int y) const;
+
+	void collectEdges(OUT std::vector<Edge>& edges) const;
+
+	//begin end  ΰ from, to ƴ   ĭ .
+	int getCrossCost(const Point& begin, const Point& end, bool isHorizontalFirst, int from, int to) const;
+
+	// ĭ Ǵ.  ׵θ   ĭ ,  .
+	void carveHallway(const Point& begin, const Point& end, bool isHorizontalFirst);
+
+	std::int64_t getRoomInnerArea() const;
+
+	const int TRY_NUM = 30;
+
+	int mRoomSizeMin;
+	int mRoomSizeMax;
+	int mRoomGap;
+	float mExtraEdgeRate;
+	int mRoomNumMax = 0;
+
+	std::vector<Room> mRooms;
+	std::vector<int> mParentRooms; //     . ù  -1
+	std::vector<Point> mHallways;
+
+	// ؽ.    ĭ   ĭ  ȣ  Ʈ д.
+	//  ĭ roomSizeMax + roomGap̶ ĥ  ִ  ׻ ٷ  ĭ ȿ ִ.
+	int mCellSize = 1;
+	int mCellWidth = 0;
+	int mCellHeight = 0;
+	std::vector<int> mCellHeads;
+	std::vector<int> mCellNexts;
+
+	GenerationControl mControl;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,446 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include "serialize.h"
+
+static const std::uint8_t MAGIC[3] = { 'P', 'M', 'G' };
+
+static void writeNumber(std::uint32_t number, OUT std::vector<std::uint8_t>& bytes)
+{
+	while (number >= 0x80)
+	{
+		bytes.push_back(static_cast<std::uint8_t>(number | 0x80));
+		number >>= 7;
+	}
+
+	bytes.push_back(static_cast<std::uint8_t>(number));
+}
+
+static void writeHeader(pmg::MapFormat format, int width, int height, OUT std::vector<std::uint8_t>& bytes)
+{
+	bytes.insert(bytes.end(), MAGIC, MAGIC + 3);
+	bytes.push_back(static_cast<std::uint8_t>(format));
+	writeNumber(width, bytes);
+	writeNumber(height, bytes);
+}
+
+static_assert((pmg::RLE_RUN_MAX - 1) << 3 <= std::numeric_limits<std::uint32_t>::max(), "run does not fit in 32 bits");
+
+void pmg::encodeRle(const MapView& view, OUT std::vector<std::uint8_t>& bytes, std::size_t runMax)
+{
+	writeHeader(MapFormat::Rle, view.getWidth(), view.getHeight(), bytes);
+
+	runMax = std::min(std::max(runMax, std::size_t(1)), RLE_RUN_MAX);
+
+	TileSpan buffer = view.getBuffer();
+	std::size_t begin = 0;
+
+	while (begin < buffer.size())
+	{
+		TileType tile = buffer[begin];
+		std::size_t end = begin + 1;
+
+		// - 1 3Ʈ о 32Ʈ Ƿ ׺    .
+		while (end < buffer.size() && buffer[end] == tile && end - begin < runMax)
+			end++;
+
+		writeNumber(static_cast<std::uint32_t>(end - begin - 1) << 3 | static_cast<std::uint32_t>(tile), bytes);
+		begin = end;
+	}
+}
+
+void pmg::encodeLayout(BSP& generator, OUT std::vector<std::uint8_t>& bytes)
+{
+	writeHeader(MapFormat::Layout, generator.getWidth(), generator.getHeight(), bytes);
+
+	std::vector<Room*> rooms;
+	generator.getRoot().getLeafRooms(rooms);
+
+	// پ ִ  ϳ ó      Ѵ.
+	std::vector<const Room*> group;
+
+	for (auto first : rooms)
+	{
+		if (first->getGroup() != first)
+			continue;
+
+		group.clear();
+
+		const Room* now = first;
+
+		do
+		{
+			group.push_back(now);
+			now = now->getGroupNext();
+		} while (now != first);
+
+		bytes.push_back(1);
+		writeNumber(static_cast<std::uint32_t>(group.size()), bytes);
+
+		for (auto room : group)
+		{
+			writeNumber(room->mX, bytes);
+			writeNumber(room->mY, bytes);
+			writeNumber(room->mWidth, bytes);
+			writeNumber(room->mHeight, bytes);
+			writeNumber(static_cast<std::uint32_t>(room->mDoors.size()), bytes);
+
+			for (auto& door : room->mDoors)
+			{
+				writeNumber(door.mX, bytes);
+				writeNumber(door.mY, bytes);
+			}
+		}
+	}
+
+	// ¿ ̾  ̹Ƿ    η .
+	std::vector<Point> hallways;
+	generator.getRoot().getAllHallways(hallways);
+
+	std::size_t begin = 0;
+
+	while (begin < hallways.size())
+	{
+		std::size_t end = begin + 1;
+
+		while (end < hallways.size() &&
+			std::abs(hallways[end].mX - hallways[end - 1].mX) + std::abs(hallways[end].mY - hallways[end - 1].mY) == 1)
+		{
+			end++;
+		}
+
+		bytes.push_back(2);
+		writeNumber(hallways[begin].mX, bytes);
+		writeNumber(hallways[begin].mY, bytes);
+		writeNumber(static_cast<std::uint32_t>(end - begin - 1), bytes);
+
+		std::uint8_t packed = 0;
+		int packedNum = 0;
+
+		for (std::size_t i = begin + 1; i < end; i++)
+		{
+			Direction dir;
+
+			if (hallways[i].mY < hallways[i - 1].mY)
+				dir = Direction::Top;
+			else if (hallways[i].mX > hallways[i - 1].mX)
+				dir = Direction::Right;
+			else if (hallways[i].mY > hallways[i - 1].mY)
+				dir = Direction::Bottom;
+			else
+				dir = Direction::Left;
+
+			packed |= static_cast<std::uint8_t>(dir) << (packedNum * 2);
+
+			if (++packedNum == 4)
+			{
+				bytes.push_back(packed);
+				packed = 0;
+				packedNum = 0;
+			}
+		}
+
+		if (packedNum > 0)
+			bytes.push_back(packed);
+
+		begin = end;
+	}
+
+	bytes.push_back(0);
+}
+
+void pmg::MapDecoder::reset()
+{
+	mWidth = 0;
+	mHeight = 0;
+	mData.clear();
+	mPending.clear();
+	mFormat = MapFormat::Rle;
+	mHasHeader = false;
+	mIsComplete = false;
+	mIsFailed = false;
+	mCursor = 0;
+}
+
+bool pmg::MapDecoder::feed(const std::uint8_t* data, std::size_t size)
+{
+	if (mIsFailed)
+		return false;
+
+	mPending.insert(mPending.end(), data, data + size);
+
+	std::size_t pos = 0;
+
+	while (!mIsComplete && pos < mPending.size())
+	{
+		bool isRead;
+
+		if (!mHasHeader)
+			isRead = readHeader(pos);
+		else if (mFormat == MapFormat::Rle)
+			isRead = readRun(pos);
+		else
+			isRead = readRecord(pos);
+
+		if (mIsFailed)
+			return false;
+
+		if (!isRead)
+			break;
+	}
+
+	//  ڵ    ڵ常 .
+	mPending.erase(mPending.begin(), mPending.begin() + pos);
+
+	return true;
+}
+
+bool pmg::MapDecoder::readNumber(std::size_t& pos, OUT std::uint32_t& number)
+{
+	number = 0;
+
+	for (int i = 0; i < 5; i++)
+	{
+		if (pos + i >= mPending.size())
+			return false;
+
+		std::uint8_t byte = mPending[pos + i];
+		number |= static_cast<std::uint32_t>(byte & 0x7f) << (i * 7);
+
+		if ((byte & 0x80) == 0)
+		{
+			pos += i + 1;
+			return true;
+		}
+	}
+
+	mIsFailed = true;
+	return false;
+}
+
+bool pmg::MapDecoder::readHeader(std::size_t& pos)
+{
+	std::size_t now = pos;
+	std::uint32_t width, height;
+
+	if (mPending.size() < now + 4)
+		return false;
+
+	if (!std::equal(MAGIC, MAGIC + 3, mPending.begin() + now) ||
+		(mPending[now + 3] != static_cast<std::uint8_t>(MapFormat::Rle) &&
+		mPending[now + 3] != static_cast<std::uint8_t>(MapFormat::Layout)))
+	{
+		mIsFailed = true;
+		return false;
+	}
+
+	mFormat = static_cast<MapFormat>(mPending[now + 3]);
+	now += 4;
+
+	if (!readNumber(now, width) || !readNumber(now, height))
+		return false;
+
+	//int  Ѱų ۸    ũ  ͷ .
+	const std::uint32_t maxSide = static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+
+	if (width > maxSide || height > maxSide ||
+		(width != 0 && height != 0 && !isValidSize(static_cast<int>(width), static_cast<int>(height))))
+	{
+		mIsFailed = true;
+		return false;
+	}
+
+	mWidth = static_cast<int>(width);
+	mHeight = static_cast<int>(height);
+	mData.assign(static_cast<std::size_t>(mWidth) * mHeight, TileType::Wall);
+	mHasHeader = true;
+	mIsComplete = mFormat == MapFormat::Rle && mData.empty();
+
+	pos = now;
+	return true;
+}
+
+bool pmg::MapDecoder::readRun(std::size_t& pos)
+{
+	std::uint32_t run;
+
+	if (!readNumber(pos, run))
+		return false;
+
+	std::size_t length = (run >> 3) + 1;
+
+	if (mCursor + length > mData.size() || (run & 7) > static_cast<std::uint32_t>(TileType::DownStair))
+	{
+		mIsFailed = true;
+		return false;
+	}
+
+	std::fill(mData.begin() + mCursor, mData.begin() + mCursor + length, static_cast<TileType>(run & 7));
+	mCursor += length;
+	mIsComplete = mCursor == mData.size();
+
+	return true;
+}
+
+bool pmg::MapDecoder::readRecord(std::size_t& pos)
+{
+	switch (static_cast<Tag>(mPending[pos]))
+	{
+	case Tag::End:
+		pos++;
+		mIsComplete = true;
+		return true;
+	case Tag::RoomGroup:
+		return readRoomGroup(pos);
+	case Tag::Hallway:
+		return readHallway(pos);
+	}
+
+	mIsFailed = true;
+	return false;
+}
+
+bool pmg::MapDecoder::readRoomGroup(std::size_t& pos)
+{
+	std::size_t now = pos + 1;
+	std::uint32_t rectNum;
+	std::vector<Rectangle> rects;
+	std::vector<Point> doors;
+
+	if (!readNumber(now, rectNum))
+		return false;
+
+	for (std::uint32_t i = 0; i < rectNum; i++)
+	{
+		std::uint32_t x, y, width, height, doorNum;
+
+		if (!readNumber(now, x) || !readNumber(now, y) ||
+			!readNumber(now, width) || !readNumber(now, height) || !readNumber(now, doorNum))
+		{
+			return false;
+		}
+
+		//ϱ   ũ⸦  ,  64Ʈ ؼ ġ ʰ Ѵ.
+		if (width == 0 || height == 0 ||
+			x >= static_cast<std::uint32_t>(mWidth) || y >= static_cast<std::uint32_t>(mHeight) ||
+			static_cast<std::uint64_t>(x) + width > static_cast<std::uint64_t>(mWidth) ||
+			static_cast<std::uint64_t>(y) + height > static_cast<std::uint64_t>(mHeight))
+		{
+			mIsFailed = true;
+			return false;
+		}
+
+		rects.emplace_back(x, y, width, height);
+
+		for (std::uint32_t d = 0; d < doorNum; d++)
+		{
+			std::uint32_t doorX, doorY;
+
+			if (!readNumber(now, doorX) || !readNumber(now, doorY))
+				return false;
+
+			if (!rects.back().isContain(Point(doorX, doorY)))
+			{
+				mIsFailed = true;
+				return false;
+			}
+
+			doors.emplace_back(doorX, doorY);
+		}
+	}
+
+	fillRoomGroup(rects, doors);
+
+	pos = now;
+	return true;
+}
+
+bool pmg::MapDecoder::readHallway(std::size_t& pos)
+{
+	std::size_t now = pos + 1;
+	std::uint32_t x, y, stepNum;
+
+	if (!readNumber(now, x) || !readNumber(now, y) || !readNumber(now, stepNum))
+		return false;
+
+	std::size_t packedNum = (static_cast<std::size_t>(stepNum) + 3) / 4;
+
+	if (mPending.size() < now + packedNum)
+		return false;
+
+	//ΰ   ϳ ĥ ʵ  ȮѴ.
+	for (int pass = 0; pass < 2; pass++)
+	{
+		Point p(x, y);
+
+		if (!isInside(p.mX, p.mY))
+		{
+			mIsFailed = true;
+			return false;
+		}
+
+		if (pass == 1)
+			mData[toIndex(p.mX, p.mY, mWidth)] = TileType::Hall;
+
+		for (std::uint32_t i = 0; i < stepNum; i++)
+		{
+			switch (static_cast<Direction>((mPending[now + i / 4] >> (i % 4 * 2)) & 3))
+			{
+			case Direction::Top: p.mY--; break;
+			case Direction::Right: p.mX++; break;
+			case Direction::Bottom: p.mY++; break;
+			case Direction::Left: p.mX--; break;
+			}
+
+			if (!isInside(p.mX, p.mY))
+			{
+				mIsFailed = true;
+				return false;
+			}
+
+			if (pass == 1)
+				mData[toIndex(p.mX, p.mY, mWidth)] = TileType::Hall;
+		}
+	}
+
+	pos = now + packedNum;
+	return true;
+}
+
+void pmg::MapDecoder::fillRoomGroup(const std::vector<Rectangle>& rects, const std::vector<Point>& doors)
+{
+	auto isInGroup = [&rects](int x, int y)
+	{
+		return std::any_of(rects.begin(), rects.end(), [x, y](const Rectangle& r)
+		{
+			return r.isContain(Point(x, y));
+		});
+	};
+
+	//Room::isWallPos  Ģ. 8 ̿  ϳ  ̸ ̴.
+	for (auto& room : rects)
+	{
+		for (int y = room.mY; y < room.getBottom() + 1; y++)
+		{
+			for (int x = room.mX; x < room.getRight() + 1; x++)
+			{
+				bool isWall = false;
+
+				for (int dy = -1; dy <= 1 && !isWall; dy++)
+				{
+					for (int dx = -1; dx <= 1 && !isWall; dx++)
+					{
+						isWall = !isInGroup(x + dx, y + dy);
+					}
+				}
+
+				mData[toIndex(x, y, mWidth)] = isWall ? TileType::Wall : TileType::Room;
+			}
+		}
+	}
+
+	for (auto& door : doors)
+	{
+		mData[toIndex(door.mX, door.mY, mWidth)] = TileType::Door;
+	}
+}
\ No newline at end of file
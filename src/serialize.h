@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "types.h"
+#include "mapView.h"
+#include "bsp.h"
+
+#ifndef OUT
+#define OUT
+#endif
+
+namespace pmg
+{
+
+//   .
+// : 'P' 'M' 'G'  , ʺ,  (ڴ  LEB128   )
+//'R'  켱   ȣȭ.  ( - 1) << 3 | Ÿ  ϳ.   Ѿ  ְ 2^29ĭ  .
+//'L' BSP ġ. ڵ ̰  ڵ ±  Ʈ Ѵ.
+//     : 簢 , 簢 x y ʺ    ( x y)...
+//    :  x y,  ,  Direction 2Ʈ ( Ʈ 4)
+//    
+enum class MapFormat : std::uint8_t
+{
+	Rle = 'R',
+	Layout = 'L'
+};
+
+// ϳ ִ . ( - 1) << 3 32Ʈ   ū ̴.
+const std::size_t RLE_RUN_MAX = std::size_t(1) << 29;
+
+//Ÿ  켱   ȣȭѴ. runMax     runMax 1 ~ RLE_RUN_MAX .
+//runMax   θ   Ȯ  ٲ۴.  ̵ ڵ  .
+void encodeRle(const MapView& view, OUT std::vector<std::uint8_t>& bytes, std::size_t runMax = RLE_RUN_MAX);
+
+template<typename Generator>
+void encodeRle(const Generator& generator, OUT std::vector<std::uint8_t>& bytes)
+{
+	encodeRle(generator.getView(), bytes);
+}
+
+//BSP  Ÿ   簢,  ġ,  η Ѵ. ڵ  createMap  .
+void encodeLayout(BSP& generator, OUT std::vector<std::uint8_t>& bytes);
+
+//   д ڴ.  ŭ feed  ϼ ڵ ٷ ŸϿ ݿϰ
+//   ڵ ϳ ܵд.   ں getView() κ    ִ.
+class MapDecoder : public TileMap
+{
+public:
+	MapDecoder() : TileMap(0, 0) { reset(); }
+
+	void reset();
+
+	//߸ ͸ false ȯ.  feed  õȴ.
+	bool feed(const std::uint8_t* data, std::size_t size);
+
+	bool feed(const std::vector<std::uint8_t>& bytes)
+	{
+		return feed(bytes.data(), bytes.size());
+	}
+
+	bool isComplete() const { return mIsComplete; }
+	bool isFailed() const { return mIsFailed; }
+
+private:
+	enum class Tag : std::uint8_t
+	{
+		End = 0,
+		RoomGroup = 1,
+		Hallway = 2
+	};
+
+	//pos ڵ ϳ д´. Ͱ ڶ pos ״ ΰ false.
+	bool readHeader(std::size_t& pos);
+	bool readRun(std::size_t& pos);
+	bool readRecord(std::size_t& pos);
+	bool readRoomGroup(std::size_t& pos);
+	bool readHallway(std::size_t& pos);
+
+	bool readNumber(std::size_t& pos, OUT std::uint32_t& number);
+
+	void fillRoomGroup(const std::vector<Rectangle>& rects, const std::vector<Point>& doors);
+	bool isInside(int x, int y) const { return x >= 0 && y >= 0 && x < mWidth && y < mHeight; }
+
+	std::vector<std::uint8_t> mPending;
+	MapFormat mFormat;
+	bool mHasHeader;
+	bool mIsComplete;
+	bool mIsFailed;
+	std::size_t mCursor; //Rle    Ÿ ġ
+};
+
+}
\ No newline at end of file
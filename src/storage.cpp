@@ -0,0 +1,94 @@
+#include "storage.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cstdlib>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+void* pmg::allocateMapped(const std::string& directory, std::size_t bytes)
+{
+	if (bytes == 0)
+		bytes = 1;
+
+	char path[MAX_PATH];
+
+	if (GetTempFileNameA(directory.c_str(), "pmg", 0, path) == 0)
+		return nullptr;
+
+	//ڵ   ϵ .
+	HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	unsigned long long size = bytes;
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFFull), nullptr);
+
+	CloseHandle(file);
+
+	if (mapping == nullptr)
+		return nullptr;
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+
+	//䰡  ִ  ε  ִ.
+	CloseHandle(mapping);
+
+	return data;
+}
+
+void pmg::freeMapped(void* data, std::size_t)
+{
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+}
+
+#else
+
+void* pmg::allocateMapped(const std::string& directory, std::size_t bytes)
+{
+	if (bytes == 0)
+		bytes = 1;
+
+	std::string path = directory + "/pmgXXXXXX";
+	std::vector<char> name(path.begin(), path.end());
+	name.push_back('\0');
+
+	int file = mkstemp(name.data());
+
+	if (file < 0)
+		return nullptr;
+
+	//      Ƿ ̸ ٷ .
+	unlink(name.data());
+
+	if (ftruncate(file, static_cast<off_t>(bytes)) != 0)
+	{
+		close(file);
+		return nullptr;
+	}
+
+	void* data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+	close(file);
+
+	return data == MAP_FAILED ? nullptr : data;
+}
+
+void pmg::freeMapped(void* data, std::size_t bytes)
+{
+	if (data != nullptr)
+		munmap(data, bytes == 0 ? 1 : bytes);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "types.h"
+
+namespace pmg
+{
+
+//directory ȿ ̸  ӽ   bytes ũ ޸ Ѵ. ϸ nullptr.
+// ڸ Ƿ  Ǯ ũ .
+void* allocateMapped(const std::string& directory, std::size_t bytes);
+void freeMapped(void* data, std::size_t bytes);
+
+//directory   , ƴϸ  ͸ ޸  Ͽ Ҵϴ Ҵ.
+//  ø  ū  ü ʿ κи ޸𸮿 ΰ  Ϸ   ִ.
+template<typename T>
+class MappedAllocator
+{
+public:
+	typedef T value_type;
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	MappedAllocator() { }
+	explicit MappedAllocator(const std::string& directory)
+		: mDirectory(directory.empty() ? nullptr : std::make_shared<const std::string>(directory))
+	{
+	}
+
+	template<typename U>
+	MappedAllocator(const MappedAllocator<U>& other) : mDirectory(other.getDirectoryPtr()) { }
+
+	T* allocate(std::size_t num)
+	{
+		if (num > static_cast<std::size_t>(-1) / sizeof(T))
+			throw std::bad_alloc();
+
+		if (mDirectory == nullptr)
+			return static_cast<T*>(::operator new(num * sizeof(T)));
+
+		void* data = allocateMapped(*mDirectory, num * sizeof(T));
+
+		if (data == nullptr)
+			throw std::bad_alloc();
+
+		return static_cast<T*>(data);
+	}
+
+	void deallocate(T* data, std::size_t num)
+	{
+		if (mDirectory == nullptr)
+			::operator delete(data);
+		else
+			freeMapped(data, num * sizeof(T));
+	}
+
+	bool isMapped() const { return mDirectory != nullptr; }
+	const std::shared_ptr<const std::string>& getDirectoryPtr() const { return mDirectory; }
+
+	// ͸  Ҵ ޸𸮸   ִ.
+	template<typename U>
+	bool operator ==(const MappedAllocator<U>& rhs) const
+	{
+		const std::shared_ptr<const std::string>& other = rhs.getDirectoryPtr();
+
+		if (mDirectory == nullptr || other == nullptr)
+			return mDirectory == other;
+
+		return *mDirectory == *other;
+	}
+
+	template<typename U>
+	bool operator !=(const MappedAllocator<U>& rhs) const { return !(*this == rhs); }
+
+private:
+	std::shared_ptr<const std::string> mDirectory;
+};
+
+// Ÿ . ⺻ ̰ TileMap::setMappedStorage   ٲ  ִ.
+typedef std::vector<TileType, MappedAllocator<TileType>> TileBuffer;
+
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <cstring>
+#include <fstream>
+#include "trace.h"
+
+pmg::trace::Histogram::Histogram(const char* name) : mName(name)
+{
+	clear();
+}
+
+void pmg::trace::Histogram::clear()
+{
+	for (auto& bucket : mBuckets)
+	{
+		bucket.store(0);
+	}
+}
+
+pmg::trace::Tracer& pmg::trace::Tracer::get()
+{
+	static Tracer tracer;
+
+	return tracer;
+}
+
+pmg::trace::Counter& pmg::trace::Tracer::getCounter(const char* name)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	for (auto& counter : mCounters)
+	{
+		if (std::strcmp(counter.getName(), name) == 0)
+			return counter;
+	}
+
+	mCounters.emplace_back(name);
+
+	return mCounters.back();
+}
+
+pmg::trace::Histogram& pmg::trace::Tracer::getHistogram(const char* name)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	for (auto& histogram : mHistograms)
+	{
+		if (std::strcmp(histogram.getName(), name) == 0)
+			return histogram;
+	}
+
+	mHistograms.emplace_back(name);
+
+	return mHistograms.back();
+}
+
+pmg::trace::Tracer::ThreadBuffer& pmg::trace::Tracer::getThreadBuffer()
+{
+	thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+	if (buffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		buffer = std::make_shared<ThreadBuffer>();
+		buffer->mThreadId = static_cast<int>(mBuffers.size());
+		mBuffers.push_back(buffer);
+	}
+
+	return *buffer;
+}
+
+void pmg::trace::Tracer::addEvent(const Event& event)
+{
+	getThreadBuffer().mEvents.push_back(event);
+}
+
+void pmg::trace::Tracer::clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	for (auto& counter : mCounters)
+	{
+		counter.clear();
+	}
+
+	for (auto& histogram : mHistograms)
+	{
+		histogram.clear();
+	}
+
+	for (auto& buffer : mBuffers)
+	{
+		buffer->mEvents.clear();
+	}
+}
+
+void pmg::trace::Tracer::writeChromeTrace(std::ostream& stream) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	std::int64_t now = getTime();
+	bool isFirst = true;
+
+	auto separate = [&stream, &isFirst]()
+	{
+		stream << (isFirst ? "\n" : ",\n");
+		isFirst = false;
+	};
+
+	stream << "{\"traceEvents\": [";
+
+	for (auto& buffer : mBuffers)
+	{
+		for (auto& event : buffer->mEvents)
+		{
+			separate();
+			stream << "{\"name\": \"" << event.mName << "\", \"ph\": \"" << event.mPhase
+				<< "\", \"ts\": " << event.mBegin << ", \"pid\": 1, \"tid\": " << buffer->mThreadId;
+
+			if (event.mPhase == 'X')
+				stream << ", \"dur\": " << event.mDuration;
+			else
+				stream << ", \"s\": \"t\"";
+
+			stream << "}";
+		}
+	}
+
+	//īͿ ׷    ī ̺Ʈ ϳ .
+	for (auto& counter : mCounters)
+	{
+		separate();
+		stream << "{\"name\": \"" << counter.getName() << "\", \"ph\": \"C\", \"ts\": " << now
+			<< ", \"pid\": 1, \"tid\": 0, \"args\": {\"value\": " << counter.getValue() << "}}";
+	}
+
+	for (auto& histogram : mHistograms)
+	{
+		separate();
+		stream << "{\"name\": \"" << histogram.getName() << "\", \"ph\": \"C\", \"ts\": " << now
+			<< ", \"pid\": 1, \"tid\": 0, \"args\": {";
+
+		bool isFirstBucket = true;
+
+		for (int i = 0; i < Histogram::BUCKET_NUM; i++)
+		{
+			if (histogram.getBucket(i) == 0)
+				continue;
+
+			stream << (isFirstBucket ? "" : ", ") << "\"<" << (std::uint64_t(1) << i)
+				<< "\": " << histogram.getBucket(i);
+			isFirstBucket = false;
+		}
+
+		stream << "}}";
+	}
+
+	stream << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+bool pmg::trace::Tracer::writeChromeTrace(const std::string& path) const
+{
+	std::ofstream stream(path);
+
+	if (!stream.is_open())
+		return false;
+
+	writeChromeTrace(stream);
+
+	return stream.good();
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//  . PMG_ENABLE_TRACE ϰ   Ʒ ũΰ ڵ带 .
+//  ũΰ ڱ ° Ƿ  忡   .
+//
+//PMG_TRACE_SCOPE(name)            :    ð ̺Ʈ .
+//PMG_TRACE_COUNT(name, value)     : īͿ value Ѵ.
+//PMG_TRACE_HISTOGRAM(name, value) : value 2 ŵ  ׷ ִ´.
+//PMG_TRACE_EVENT(name)            :  ̺Ʈ .
+//
+//name ڿ ͷ̾ Ѵ.  pmg::trace::Tracer::get().writeChromeTrace()
+//chrome://tracing̳ Perfetto   ִ JSON .
+
+namespace pmg
+{
+namespace trace
+{
+
+class Counter
+{
+public:
+	Counter(const char* name) : mName(name), mValue(0) { }
+
+	void add(std::int64_t value) { mValue.fetch_add(value, std::memory_order_relaxed); }
+
+	const char* getName() const { return mName; }
+	std::int64_t getValue() const { return mValue.load(std::memory_order_relaxed); }
+	void clear() { mValue.store(0); }
+
+private:
+	const char* mName;
+	std::atomic<std::int64_t> mValue;
+};
+
+// i [2^(i-1), 2^i)  . 0  0.
+class Histogram
+{
+public:
+	static const int BUCKET_NUM = 64;
+
+	Histogram(const char* name);
+
+	void record(std::uint64_t value)
+	{
+		int bucket = 0;
+
+		while (value != 0 && bucket < BUCKET_NUM - 1)
+		{
+			value >>= 1;
+			bucket++;
+		}
+
+		mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	const char* getName() const { return mName; }
+	std::int64_t getBucket(int bucket) const { return mBuckets[bucket].load(std::memory_order_relaxed); }
+	void clear();
+
+private:
+	const char* mName;
+	std::atomic<std::int64_t> mBuckets[BUCKET_NUM];
+};
+
+struct Event
+{
+	const char* mName;
+	std::int64_t mBegin; //ũ
+	std::int64_t mDuration;
+	char mPhase; //'X' , 'i' 
+};
+
+//    ü. ̺Ʈ 帶  Ƿ    ʴ´.
+//writeChromeTrace clear     ҷ Ѵ.
+class Tracer
+{
+public:
+	static Tracer& get();
+
+	// ̸̸  ü. ȣ ġ   ã ũο static  ִ´.
+	Counter& getCounter(const char* name);
+	Histogram& getHistogram(const char* name);
+
+	void addEvent(const Event& event);
+
+	//Tracer ó    ũ.
+	std::int64_t getTime() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - mStart).count();
+	}
+
+	void clear();
+
+	void writeChromeTrace(std::ostream& stream) const;
+	bool writeChromeTrace(const std::string& path) const;
+
+private:
+	struct ThreadBuffer
+	{
+		int mThreadId;
+		std::vector<Event> mEvents;
+	};
+
+	Tracer() : mStart(std::chrono::steady_clock::now()) { }
+
+	ThreadBuffer& getThreadBuffer();
+
+	mutable std::mutex mMutex;
+	std::deque<Counter> mCounters;
+	std::deque<Histogram> mHistograms;
+	std::vector<std::shared_ptr<ThreadBuffer>> mBuffers; //尡   
+	std::chrono::steady_clock::time_point mStart;
+};
+
+class ScopedTimer
+{
+public:
+	ScopedTimer(const char* name) : mName(name), mBegin(Tracer::get().getTime()) { }
+
+	~ScopedTimer()
+	{
+		Tracer& tracer = Tracer::get();
+
+		tracer.addEvent({ mName, mBegin, tracer.getTime() - mBegin, 'X' });
+	}
+
+private:
+	const char* mName;
+	std::int64_t mBegin;
+};
+
+}
+}
+
+#ifdef PMG_ENABLE_TRACE
+
+#define PMG_TRACE_CONCAT_IMPL(a, b) a##b
+#define PMG_TRACE_CONCAT(a, b) PMG_TRACE_CONCAT_IMPL(a, b)
+
+#define PMG_TRACE_SCOPE(name) \
+	::pmg::trace::ScopedTimer PMG_TRACE_CONCAT(pmgTraceScope, __LINE__)(name)
+
+#define PMG_TRACE_COUNT(name, value) \
+	do \
+	{ \
+		static ::pmg::trace::Counter& pmgTraceCounter = ::pmg::trace::Tracer::get().getCounter(name); \
+		pmgTraceCounter.add(static_cast<std::int64_t>(value)); \
+	} while (false)
+
+#define PMG_TRACE_HISTOGRAM(name, value) \
+	do \
+	{ \
+		static ::pmg::trace::Histogram& pmgTraceHistogram = ::pmg::trace::Tracer::get().getHistogram(name); \
+		pmgTraceHistogram.record(static_cast<std::uint64_t>(value)); \
+	} while (false)
+
+#define PMG_TRACE_EVENT(name) \
+	::pmg::trace::Tracer::get().addEvent({ name, ::pmg::trace::Tracer::get().getTime(), 0, 'i' })
+
+#else
+
+#define PMG_TRACE_SCOPE(name) ((void)0)
+#define PMG_TRACE_COUNT(name, value) ((void)0)
+#define PMG_TRACE_HISTOGRAM(name, value) ((void)0)
+#define PMG_TRACE_EVENT(name) ((void)0)
+
+#endif
\ No newline at end of file
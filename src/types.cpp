@@ -0,0 +1,26 @@
+#include "types.h"
+
+bool pmg::Rectangle::isConnect(const Rectangle & other) const
+{
+	if (mX == other.getRight() + 1 ||
+		other.mX == getRight() + 1)
+	{
+		return (mY >= other.mY && mY < other.getBottom() - 1) ||
+			(other.mY >= mY && other.mY < getBottom() - 1);
+	}
+
+	if (mY == other.mY + other.mHeight ||
+		other.mY == mY + mHeight)
+	{
+		return (mX >= other.mX && mX < other.getRight() - 1) ||
+			(other.mX >= mX && other.mX < getRight() - 1);
+	}
+
+	return false;
+}
+
+bool pmg::Rectangle::isContain(const Point & pos) const
+{
+	return pos.mX >= mX && pos.mX <= getRight() &&
+		pos.mY >= mY && pos.mY <= getBottom();
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 namespace pmg
 {
@@ -11,14 +13,23 @@ enum class Direction
 	Left = 3
 };
 
-enum class TileType
+//ū ʿ ޸𸮸 ̱   ĭ 1Ʈ .
+enum class TileType : std::uint8_t
 {
 	Wall,
 	Hall,
 	Room,
-	Door
+	Door,
+	UpStair, //  
+	DownStair //Ʒ  
 };
 
+// 켱 ۿ (x, y) ġ. ĭ  int  Ѵ ū ʿ ġ ʵ size_t Ѵ.
+inline std::size_t toIndex(int x, int y, int width)
+{
+	return static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x);
+}
+
 struct Point
 {
 	Point() : mX(0), mY(0) { }
@@ -32,4 +43,21 @@ struct Point
 	int mY;
 };
 
+struct Rectangle
+{
+	Rectangle() : mX(0), mY(0), mWidth(0), mHeight(0) { }
+	Rectangle(int x, int y, int width, int height) : mX(x), mY(y), mWidth(width), mHeight(height) { }
+
+	bool isConnect(const Rectangle& other) const;
+	bool isContain(const Point& pos) const;
+
+	int getRight() const { return mX + mWidth - 1; }
+	int getBottom() const { return mY + mHeight - 1; }
+
+	int mX;
+	int mY;
+	int mWidth;
+	int mHeight;
+};
+
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "validator.h"
+
+bool pmg::MapConstraint::isSatisfied(const MapStats& stats) const
+{
+	float walkableRate = stats.getWalkableRate();
+
+	if (walkableRate < mMinWalkableRate || walkableRate > mMaxWalkableRate)
+		return false;
+
+	if (stats.mRoomNum < mMinRoomNum || stats.mDoorNum < mMinDoorNum)
+		return false;
+
+	if (stats.mDeadEndNum > mMaxDeadEndNum)
+		return false;
+
+	if (mIsConnected && stats.mRegionNum > 1)
+		return false;
+
+	return true;
+}
+
+//computeStats ĭ δ ǥ.     Ʈ  Ѵ.
+static const std::uint8_t REGION_MARK = 1;
+static const std::uint8_t ROOM_MARK = 2;
+
+//start  isSame ϴ ĭ ¿ 󰡸 bit ǥѴ. ǥ ĭ  ȯ.
+template<typename Predicate>
+static std::int64_t floodFill(const pmg::TileType* data, int width, int height, std::size_t start, std::uint8_t bit,
+	std::vector<std::uint8_t>& mark, std::vector<std::size_t>& stack, Predicate isSame)
+{
+	std::int64_t num = 0;
+	const std::size_t none = static_cast<std::size_t>(-1);
+
+	mark[start] |= bit;
+	stack.push_back(start);
+
+	while (!stack.empty())
+	{
+		std::size_t now = stack.back();
+		stack.pop_back();
+		num++;
+
+		int x = static_cast<int>(now % width);
+		int y = static_cast<int>(now / width);
+		std::size_t adjs[4] =
+		{
+			x > 0 ? now - 1 : none,
+			x < width - 1 ? now + 1 : none,
+			y > 0 ? now - width : none,
+			y < height - 1 ? now + width : none
+		};
+
+		for (std::size_t adj : adjs)
+		{
+			if (adj != none && (mark[adj] & bit) == 0 && isSame(data[adj]))
+			{
+				mark[adj] |= bit;
+				stack.push_back(adj);
+			}
+		}
+	}
+
+	return num;
+}
+
+pmg::MapStats pmg::computeStats(const MapView& view)
+{
+	const TileType* data = view.getBuffer().getData();
+	int width = view.getWidth();
+	int height = view.getHeight();
+
+	MapStats stats;
+
+	stats.mWidth = width;
+	stats.mHeight = height;
+
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			TileType tile = data[toIndex(x, y, width)];
+
+			if (!isWalkable(tile))
+				continue;
+
+			stats.mWalkableNum++;
+
+			if (tile == TileType::Door)
+				stats.mDoorNum++;
+
+			if (tile == TileType::Hall)
+				stats.mHallNum++;
+
+			int adjust = 0;
+
+			if (x > 0 && isWalkable(data[toIndex(x - 1, y, width)])) adjust++;
+			if (x < width - 1 && isWalkable(data[toIndex(x + 1, y, width)])) adjust++;
+			if (y > 0 && isWalkable(data[toIndex(x, y - 1, width)])) adjust++;
+			if (y < height - 1 && isWalkable(data[toIndex(x, y + 1, width)])) adjust++;
+
+			if (adjust == 1)
+				stats.mDeadEndNum++;
+		}
+	}
+
+	//  ִ  Room    flood fill .
+	std::size_t size = view.getBuffer().size();
+	std::vector<std::uint8_t> mark(size, 0);
+	std::vector<std::size_t> stack;
+
+	for (std::size_t i = 0; i < size; i++)
+	{
+		if (isWalkable(data[i]) && (mark[i] & REGION_MARK) == 0)
+		{
+			stats.mRegionNum++;
+
+			std::int64_t num = floodFill(data, width, height, i, REGION_MARK, mark, stack, &isWalkable);
+
+			if (num > stats.mLargestRegionNum)
+				stats.mLargestRegionNum = num;
+		}
+
+		if (data[i] == TileType::Room && (mark[i] & ROOM_MARK) == 0)
+		{
+			stats.mRoomNum++;
+
+			floodFill(data, width, height, i, ROOM_MARK, mark, stack, [](TileType tile)
+			{
+				return tile == TileType::Room;
+			});
+		}
+	}
+
+	return stats;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include "types.h"
+#include "mapView.h"
+
+namespace pmg
+{
+
+//  ǰ ǥ.
+struct MapStats
+{
+	MapStats() : mWidth(0), mHeight(0), mWalkableNum(0), mRoomNum(0),
+		mDoorNum(0), mHallNum(0), mDeadEndNum(0), mRegionNum(0), mLargestRegionNum(0) { }
+
+	float getWalkableRate() const
+	{
+		if (mWidth <= 0 || mHeight <= 0)
+			return 0.0f;
+
+		return static_cast<float>(mWalkableNum) / (static_cast<float>(mWidth) * mHeight);
+	}
+
+	int mWidth;
+	int mHeight;
+	std::int64_t mWalkableNum; // ƴ ĭ 
+	std::int64_t mRoomNum; //Room Ÿ ¿ ̾  
+	std::int64_t mDoorNum;
+	std::int64_t mHallNum; // Ÿ .  ü ̿ .
+	std::int64_t mDeadEndNum; //¿    ִ ̿ ϳ ĭ 
+	std::int64_t mRegionNum; //  ִ ĭ ¿ ̾  
+	std::int64_t mLargestRegionNum; // ū  ĭ 
+};
+
+// ؾ ϴ . ⺻ ƹ ǵ  ʴ´.
+struct MapConstraint
+{
+	bool isSatisfied(const MapStats& stats) const;
+
+	float mMinWalkableRate = 0.0f;
+	float mMaxWalkableRate = 1.0f;
+	int mMinRoomNum = 0;
+	int mMinDoorNum = 0;
+	std::int64_t mMaxDeadEndNum = std::numeric_limits<std::int64_t>::max();
+	bool mIsConnected = false; //  ִ ĭ  ̾ ־ ϴ
+};
+
+inline bool isWalkable(TileType tile)
+{
+	return tile != TileType::Wall;
+}
+
+MapStats computeStats(const MapView& view);
+
+//getView() ϴ   ǥ Ѵ.
+template<typename Generator>
+MapStats computeStats(const Generator& generator)
+{
+	return computeStats(generator.getView());
+}
+
+template<typename Generator>
+bool isValidMap(const Generator& generator, const MapConstraint& constraint)
+{
+	return constraint.isSatisfied(computeStats(generator));
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,625 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/pmg.h"
+
+// seed ⸶     ؽÿ ϰ,  ǰ  ð ȮѴ.
+//ϳ ߳ 0 ƴ  Ƿ  ũƮ ٷ з   ִ.
+//
+//: regress <golden.txt> [--update] [--repeat 3] [--budgetScale 1.0] [--case ̸]
+//  --update      :   golden  ٽ .  ٲ  ǵ  .
+//  --repeat      : ð repeat     .
+//  --budgetScale :  迡  ð ѿ Ѵ.
+//
+//golden   ٿ "̸ ؽ(16)". ҿ tool/regress_golden.txt ִ.
+// std::uniform_int_distribution, std::uniform_real_distribution µ   
+//ǥ ̺귯 ٸ. ׷ ؽõ ǥ ̺귯  ޶.   libstdc++ ,
+//ٸ ǥ ̺귯 --update   .
+
+struct CaseResult
+{
+	std::uint64_t mHash = 0;
+	std::vector<std::string> mIssues; //   
+};
+
+struct Case
+{
+	std::string mName;
+	double mBudget; //и
+	std::function<void(CaseResult&)> mRun;
+};
+
+static void addView(const pmg::MapView& view, pmg::Fnv1a& hash)
+{
+	hash.add(view.getWidth());
+	hash.add(view.getHeight());
+
+	for (int y = 0; y < view.getHeight(); y++)
+	{
+		pmg::TileSpan row = view.getRow(y);
+
+		hash.add(row.getData(), row.size() * sizeof(pmg::TileType));
+	}
+}
+
+//   ִ ĭ ̾ ־ Ѵ.
+static void checkConnected(const std::string& name, const pmg::MapView& view, CaseResult& result)
+{
+	pmg::MapStats stats = pmg::computeStats(view);
+
+	if (stats.mRegionNum > 1)
+		result.mIssues.push_back(name + ": " + std::to_string(stats.mRegionNum) + " regions");
+}
+
+//  ׵θ , 𼭸 ƴ  ־ Ѵ.
+static void checkDoors(const std::string& name, pmg::BSP& generator, CaseResult& result)
+{
+	std::vector<pmg::Room*> rooms;
+	generator.getRoot().getLeafRooms(rooms);
+
+	for (auto room : rooms)
+	{
+		for (auto& door : room->mDoors)
+		{
+			bool isInside = door.mX >= room->mX && door.mX <= room->getRight() &&
+				door.mY >= room->mY && door.mY <= room->getBottom();
+			bool isEdgeX = door.mX == room->mX || door.mX == room->getRight();
+			bool isEdgeY = door.mY == room->mY || door.mY == room->getBottom();
+
+			if (!isInside || isEdgeX == isEdgeY || generator.getData(door.mX, door.mY) != pmg::TileType::Door)
+			{
+				result.mIssues.push_back(name + ": door (" + std::to_string(door.mX) + ", " +
+					std::to_string(door.mY) + ") is not on a room edge");
+			}
+		}
+	}
+}
+
+//  ĭ ʺ񿩾 Ѵ. Ÿ ڿ Hall ĭ   2x2 ̷  ĭ ʺ .
+// ٸ   پ  ͵  ´.
+static void checkHallWidth(const std::string& name, const pmg::MapView& view, CaseResult& result)
+{
+	auto isHall = [&](int x, int y) { return view.getData(x, y) == pmg::TileType::Hall; };
+
+	for (int y = 0; y + 1 < view.getHeight(); y++)
+	{
+		for (int x = 0; x + 1 < view.getWidth(); x++)
+		{
+			if (isHall(x, y) && isHall(x + 1, y) && isHall(x, y + 1) && isHall(x + 1, y + 1))
+			{
+				result.mIssues.push_back(name + ": 2-wide hall at (" + std::to_string(x) + ", " +
+					std::to_string(y) + ")");
+			}
+		}
+	}
+}
+
+static void runBsp(bool isParallel, int width, int height, int complexity, CaseResult& result)
+{
+	pmg::Fnv1a hash;
+
+	for (unsigned int seed = 0; seed < 8; seed++)
+	{
+		pmg::BSP generator(width, height, 5, 0.2f, 0.6f, 0.2f, complexity);
+		std::string name = "seed " + std::to_string(seed);
+
+		generator.setParallel(isParallel, 4);
+		generator.createMap(seed);
+
+		addView(generator.getView(), hash);
+		checkConnected(name, generator.getView(), result);
+		checkDoors(name, generator, result);
+		checkHallWidth(name, generator.getView(), result);
+	}
+
+	result.mHash = hash.get();
+}
+
+//generator.createMap(seed) seedNum    ؽѴ.
+template<typename Generator>
+static void runSeeds(Generator& generator, int seedNum, CaseResult& result)
+{
+	pmg::Fnv1a hash;
+
+	for (int seed = 0; seed < seedNum; seed++)
+	{
+		generator.createMap(static_cast<unsigned int>(seed));
+		addView(generator.getView(), hash);
+	}
+
+	result.mHash = hash.get();
+}
+
+static std::vector<Case> getCases()
+{
+	std::vector<Case> cases;
+
+	cases.push_back({ "bsp.serial", 300.0, [](CaseResult& result)
+	{
+		runBsp(false, 120, 90, 2, result);
+	} });
+
+	cases.push_back({ "bsp.parallel", 300.0, [](CaseResult& result)
+	{
+		runBsp(true, 120, 90, 2, result);
+	} });
+
+	cases.push_back({ "bsp.large", 800.0, [](CaseResult& result)
+	{
+		pmg::BSP generator(400, 300, 8, 0.2f, 0.6f, 0.2f, 1);
+		runSeeds(generator, 2, result);
+	} });
+
+	cases.push_back({ "agent", 30.0, [](CaseResult& result)
+	{
+		pmg::Agent generator(200, 150, 20, 200, 0.05f, 0.2f);
+		runSeeds(generator, 8, result);
+	} });
+
+	cases.push_back({ "swarm", 80.0, [](CaseResult& result)
+	{
+		pmg::AgentSwarm generator(200, 150, 200, 60, 0.05f, 0.2f);
+		generator.setRoomDrop(0.02f, 3, 5);
+		generator.setCorridorWidth(2);
+		generator.setExploreBias(0.5f);
+		runSeeds(generator, 8, result);
+	} });
+
+	cases.push_back({ "ca", 50.0, [](CaseResult& result)
+	{
+		pmg::CellularAutomata generator(200, 150, 5, 0.45f, 5);
+		runSeeds(generator, 8, result);
+	} });
+
+	cases.push_back({ "ca.constraint", 150.0, [](CaseResult& result)
+	{
+		pmg::CellularAutomata generator(200, 150, 5, 0.45f, 5);
+		pmg::MapConstraint constraint;
+		pmg::Fnv1a hash;
+
+		constraint.mMinWalkableRate = 0.65f;
+		constraint.mMaxWalkableRate = 0.69f;
+
+		//  ޸ƽ̹Ƿ    ο Ѵ.    seed Ȯ ηε ؾ Ѵ.
+		for (unsigned int seed = 0; seed < 8; seed++)
+		{
+			generator.setEarlyReject(true);
+			bool isEarlyAccepted = generator.createMap(seed, constraint);
+
+			generator.setEarlyReject(false);
+			bool isAccepted = generator.createMap(seed, constraint);
+
+			generator.createMap(seed);
+			bool isExpected = constraint.isSatisfied(pmg::computeStats(generator));
+
+			if (isAccepted != isExpected || (isEarlyAccepted && !isAccepted))
+				result.mIssues.push_back("constraint check differs for seed " + std::to_string(seed));
+
+			hash.add(isAccepted);
+		}
+
+		result.mHash = hash.get();
+	} });
+
+	cases.push_back({ "ca.level", 40.0, [](CaseResult& result)
+	{
+		pmg::CellularAutomata generator(200, 150, 5, 0.45f, 5);
+		generator.setLevel(3, 2, 0.2f);
+		runSeeds(generator, 8, result);
+	} });
+
+	cases.push_back({ "ca.active", 80.0, [](CaseResult& result)
+	{
+		pmg::CellularAutomata generator(200, 150, 5, 0.45f, 5);
+		generator.setActiveTracking(true, 16);
+		runSeeds(generator, 8, result);
+
+		//Ϻ ݰ ū Ģ̾ ü Ź   ƾ Ѵ.
+		pmg::RuleSchedule wide = { pmg::RulePhase(pmg::makeRuleStep<pmg::Moore<3>, pmg::ThresholdRule<25>>(), 4) };
+		pmg::CellularAutomata full(120, 90, 0, 0.45f, 0);
+		pmg::CellularAutomata active(120, 90, 0, 0.45f, 0);
+
+		full.setRuleSchedule(wide);
+		active.setRuleSchedule(wide);
+		active.setActiveTracking(true, 1);
+
+		for (unsigned int seed = 0; seed < 2; seed++)
+		{
+			pmg::Fnv1a fullHash;
+			pmg::Fnv1a activeHash;
+
+			full.createMap(seed);
+			active.createMap(seed);
+			addView(full.getView(), fullHash);
+			addView(active.getView(), activeHash);
+
+			if (fullHash.get() != activeHash.get())
+				result.mIssues.push_back("seed " + std::to_string(seed) + ": active tracking differs with a radius 3 rule");
+		}
+	} });
+
+	cases.push_back({ "scatter", 250.0, [](CaseResult& result)
+	{
+		pmg::Fnv1a hash;
+
+		for (unsigned int seed = 0; seed < 8; seed++)
+		{
+			pmg::RoomScatter generator(300, 200, 5, 10, 2, 0.1f);
+
+			generator.createMap(seed);
+			addView(generator.getView(), hash);
+			checkConnected("seed " + std::to_string(seed), generator.getView(), result);
+		}
+
+		result.mHash = hash.get();
+	} });
+
+	cases.push_back({ "storage.mapped", 150.0, [](CaseResult& result)
+	{
+		pmg::Fnv1a hash;
+
+		//  ű ۴ createMap ڿ ״ ̾ ϰ    ƾ Ѵ.
+		auto check = [&](const std::string& name, pmg::TileMap& mapped, pmg::TileMap& heap)
+		{
+			pmg::Fnv1a mappedHash;
+			pmg::Fnv1a heapHash;
+
+			addView(mapped.getView(), mappedHash);
+			addView(heap.getView(), heapHash);
+			addView(mapped.getView(), hash);
+
+			if (!mapped.isMappedStorage())
+				result.mIssues.push_back(name + ": storage is no longer mapped after createMap");
+
+			if (mappedHash.get() != heapHash.get())
+				result.mIssues.push_back(name + ": mapped output differs from heap output");
+		};
+
+		for (int type = 0; type < 3; type++)
+		{
+			pmg::CellularAutomata mapped(200, 150, 5, 0.45f, 5);
+			pmg::CellularAutomata heap(200, 150, 5, 0.45f, 5);
+
+			if (type == 1)
+			{
+				mapped.setLevel(3, 2, 0.2f);
+				heap.setLevel(3, 2, 0.2f);
+			}
+			else if (type == 2)
+			{
+				mapped.setActiveTracking(true, 16);
+				heap.setActiveTracking(true, 16);
+			}
+
+			if (!mapped.setMappedStorage("."))
+			{
+				result.mIssues.push_back("cannot map storage in the current directory");
+				return;
+			}
+
+			mapped.createMap(1);
+			heap.createMap(1);
+			check("ca " + std::to_string(type), mapped, heap);
+		}
+
+		pmg::BSP mapped(120, 90, 5, 0.2f, 0.6f, 0.2f, 1);
+		pmg::BSP heap(120, 90, 5, 0.2f, 0.6f, 0.2f, 1);
+
+		mapped.setMappedStorage(".");
+		mapped.createMap(1);
+		heap.createMap(1);
+		check("bsp", mapped, heap);
+
+		result.mHash = hash.get();
+	} });
+
+	cases.push_back({ "pipeline", 400.0, [](CaseResult& result)
+	{
+		pmg::Pipeline generator(160, 120);
+		generator.addLayout(5, 0.2f, 0.6f, 0.2f, 1);
+		generator.addRoomCave(3, 0.4f, 5);
+		generator.addDoorTunnel(20, 0.1f, 0.1f);
+		runSeeds(generator, 8, result);
+
+		//ҵ ū̸ ù ܰ  ߰ false  Ѵ.
+		pmg::CancelToken token;
+		token.cancel();
+		generator.setControl(pmg::GenerationControl(token));
+
+		if (generator.createMap(0))
+			result.mIssues.push_back("cancelled pipeline reported success");
+	} });
+
+	cases.push_back({ "dungeon", 400.0, [](CaseResult& result)
+	{
+		pmg::Dungeon generator(120, 90, 4, 5, 0.2f, 0.6f, 0.2f, 1);
+		pmg::Fnv1a hash;
+
+		generator.setThreadNum(2);
+
+		for (unsigned int seed = 0; seed < 4; seed++)
+		{
+			generator.createMap(seed);
+
+			for (int f = 0; f < generator.getFloorNum(); f++)
+			{
+				addView(generator.getFloor(f), hash);
+			}
+		}
+
+		//   ũⰡ ġų     Ǿ Ѵ.
+		pmg::Dungeon huge(std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), 4, 5, 0.2f, 0.6f, 0.2f, 1);
+		pmg::Dungeon noFloor(120, 90, 0, 5, 0.2f, 0.6f, 0.2f, 1);
+
+		if (huge.getFloorNum() != 0 || huge.getWidth() != 0 || huge.createMap(0) || noFloor.createMap(0))
+			result.mIssues.push_back("invalid dungeon size was accepted");
+
+		//  ű  ۵ createMap ڿ ״ ̾ ϰ    ƾ Ѵ.
+		pmg::Dungeon mapped(120, 90, 4, 5, 0.2f, 0.6f, 0.2f, 1);
+
+		mapped.setThreadNum(2);
+		mapped.setMappedStorage(".");
+		mapped.createMap(3);
+
+		if (!mapped.isMappedStorage())
+			result.mIssues.push_back("dungeon storage is no longer mapped after createMap");
+
+		if (!std::equal(mapped.getBuffer().begin(), mapped.getBuffer().end(), generator.getBuffer().begin()))
+			result.mIssues.push_back("mapped dungeon differs from heap dungeon");
+
+		result.mHash = hash.get();
+	} });
+
+	cases.push_back({ "image.empty", 10.0, [](CaseResult& result)
+	{
+		pmg::Fnv1a hash;
+
+		//ĭ   ڵ ʰ Ϸε  ʴ´.
+		pmg::MapView empty;
+		pmg::ImageOption option;
+		std::vector<std::uint8_t> bytes;
+
+		option.mThreadNum = 2;
+		pmg::encodePpm(empty, option, bytes);
+		pmg::encodePng(empty, option, bytes);
+
+		if (!bytes.empty())
+			result.mIssues.push_back("empty map was encoded");
+
+		if (pmg::toPngFile(empty, "regress_empty.png", option) || pmg::toPpmFile(empty, "regress_empty.ppm", option))
+			result.mIssues.push_back("empty map was written");
+
+		//  ʺ 2^32 int ϸ 0 ģ. PNG ѵ Ƿ ڵ ʾƾ Ѵ.
+		std::vector<pmg::TileType> row(1 << 16, pmg::TileType::Wall);
+		pmg::MapView wide(row.data(), 1 << 16, 1);
+
+		option.mScale = 1 << 16;
+		pmg::encodePpm(wide, option, bytes);
+		pmg::encodePng(wide, option, bytes);
+
+		if (!bytes.empty())
+			result.mIssues.push_back("image wider than 2^31 - 1 pixels was encoded");
+
+		result.mHash = hash.get();
+	} });
+
+	cases.push_back({ "serialize", 100.0, [](CaseResult& result)
+	{
+		pmg::Fnv1a hash;
+
+		//x + width 32Ʈ   ˻縦 ϴ ġ . ڴ ؾ Ѵ.
+		const std::vector<std::uint8_t> wrapped = { 'P', 'M', 'G', 'L', 10, 10, 1, 1,
+			0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0, 1, 3, 0, 0 };
+		pmg::MapDecoder decoder;
+
+		if (decoder.feed(wrapped) || !decoder.isFailed())
+			result.mIssues.push_back("wrapped room rectangle was accepted");
+
+		result.mHash = hash.get();
+	} });
+
+	cases.push_back({ "serialize.split", 100.0, [](CaseResult& result)
+	{
+		pmg::Fnv1a hash;
+
+		//  θ  ѵ ȮѴ. ѵ  ,  ĭ  ,     ´.
+		// ѵ 2^29  1GB   ʿϴ.
+		const std::size_t runMax = 5;
+		const int lengths[] = { 5, 6, 1, 23, 4 };
+		std::vector<pmg::TileType> tiles;
+		std::size_t expectedRunNum = 0;
+
+		for (int i = 0; i < 5; i++)
+		{
+			tiles.insert(tiles.end(), lengths[i], i % 2 == 0 ? pmg::TileType::Wall : pmg::TileType::Room);
+			expectedRunNum += (lengths[i] + runMax - 1) / runMax;
+		}
+
+		const int width = 13;
+		const int height = static_cast<int>(tiles.size()) / width;
+		std::vector<std::uint8_t> bytes;
+		std::vector<std::uint8_t> header;
+
+		pmg::encodeRle(pmg::MapView(tiles.data(), width, height), bytes, runMax);
+		pmg::encodeRle(pmg::MapView(tiles.data(), width, 0), header);
+		hash.add(bytes.data(), bytes.size());
+
+		// ̰ Ƿ  ϳ  Ʈ.
+		if (bytes.size() - header.size() != expectedRunNum)
+			result.mIssues.push_back("runs were not split at the run limit");
+
+		pmg::MapDecoder decoder;
+
+		if (!decoder.feed(bytes) || !decoder.isComplete() ||
+			!std::equal(tiles.begin(), tiles.end(), decoder.getView().getBuffer().getData()))
+		{
+			result.mIssues.push_back("split runs do not round-trip");
+		}
+
+		result.mHash = hash.get();
+	} });
+
+	return cases;
+}
+
+static std::map<std::string, std::uint64_t> readGolden(const std::string& path)
+{
+	std::map<std::string, std::uint64_t> res;
+	std::ifstream stream(path);
+	std::string name;
+	std::string value;
+
+	while (stream >> name >> value)
+	{
+		res[name] = std::strtoull(value.c_str(), nullptr, 16);
+	}
+
+	return res;
+}
+
+static bool writeGolden(const std::string& path, const std::map<std::string, std::uint64_t>& golden)
+{
+	std::ofstream stream(path);
+
+	if (!stream.is_open())
+		return false;
+
+	for (auto& entry : golden)
+	{
+		char value[32];
+		std::snprintf(value, sizeof(value), "%016llx", static_cast<unsigned long long>(entry.second));
+		stream << entry.first << " " << value << std::endl;
+	}
+
+	return stream.good();
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "usage: regress <golden.txt> [--update] [--repeat N] [--budgetScale F] [--case name]" << std::endl;
+		return 1;
+	}
+
+	std::string goldenPath = argv[1];
+	bool isUpdate = false;
+	int repeat = 3;
+	double budgetScale = 1.0;
+	std::string onlyCase;
+
+	for (int i = 2; i < argc; i++)
+	{
+		std::string key = argv[i];
+
+		if (key == "--update")
+		{
+			isUpdate = true;
+		}
+		else if (key == "--repeat" && i + 1 < argc)
+		{
+			repeat = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (key == "--budgetScale" && i + 1 < argc)
+		{
+			budgetScale = std::atof(argv[++i]);
+		}
+		else if (key == "--case" && i + 1 < argc)
+		{
+			onlyCase = argv[++i];
+		}
+		else
+		{
+			std::cerr << "unknown option: " << key << std::endl;
+			return 1;
+		}
+	}
+
+	std::map<std::string, std::uint64_t> golden = readGolden(goldenPath);
+	int failNum = 0;
+	int runNum = 0;
+
+	for (auto& c : getCases())
+	{
+		if (!onlyCase.empty() && c.mName != onlyCase)
+			continue;
+
+		runNum++;
+
+		CaseResult result;
+		double best = 0.0;
+
+		for (int r = 0; r < repeat; r++)
+		{
+			result = CaseResult();
+
+			auto begin = std::chrono::steady_clock::now();
+			c.mRun(result);
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+			best = r == 0 ? ms : std::min(best, ms);
+		}
+
+		double budget = c.mBudget * budgetScale;
+		std::vector<std::string> failures;
+
+		for (auto& issue : result.mIssues)
+		{
+			failures.push_back("invariant: " + issue);
+		}
+
+		if (best > budget)
+			failures.push_back("over budget");
+
+		auto iter = golden.find(c.mName);
+
+		if (isUpdate)
+		{
+			golden[c.mName] = result.mHash;
+		}
+		else if (iter == golden.end())
+		{
+			failures.push_back("no golden hash");
+		}
+		else if (iter->second != result.mHash)
+		{
+			failures.push_back("output differs from golden");
+		}
+
+		std::printf("%s %-14s %8.2f ms / %8.2f ms  %016llx\n", failures.empty() ? "PASS" : "FAIL",
+			c.mName.c_str(), best, budget, static_cast<unsigned long long>(result.mHash));
+
+		for (auto& failure : failures)
+		{
+			std::printf("     %s\n", failure.c_str());
+		}
+
+		if (!failures.empty())
+			failNum++;
+	}
+
+	//̸ ߸ Ἥ ƹ͵  ʾҴµ    ȴ.
+	if (runNum == 0)
+	{
+		std::cerr << "unknown case: " << onlyCase << std::endl;
+		return 1;
+	}
+
+	if (isUpdate && !writeGolden(goldenPath, golden))
+	{
+		std::cerr << "cannot write " << goldenPath << std::endl;
+		return 1;
+	}
+
+	return failNum == 0 ? 0 : 1;
+}
\ No newline at end of file
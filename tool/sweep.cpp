@@ -0,0 +1,323 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/pmg.h"
+
+// Ķ  x õ帶   ǰ ǥ  ð CSV / JSON .
+//
+//: sweep <bsp|agent|swarm|ca|scatter> [--size 100x100] [--seeds 10] [--threads 4] [--out result.csv]
+//             [--Ķ 1,2,...]...
+//) sweep bsp --size 200x200 --seeds 20 --splitNum 4,6,8 --complexity 1,2 --out bsp.json
+
+struct Param
+{
+	std::string mName;
+	std::vector<double> mValues;
+};
+
+struct Result
+{
+	std::vector<double> mValues;
+	unsigned int mSeed;
+	double mMillisecond;
+	bool mIsDone; //createMap ߴ.   ǥ   ɷ  ְ Ѵ.
+	pmg::MapStats mStats;
+};
+
+static std::vector<Param> getDefaultParams(const std::string& type)
+{
+	if (type == "bsp")
+	{
+		return { { "splitNum", { 6 } }, { "splitRange", { 0.2 } }, { "sizeMid", { 0.6 } },
+			{ "sizeRange", { 0.2 } }, { "complexity", { 1 } } };
+	}
+
+	if (type == "agent")
+	{
+		return { { "agentNum", { 80 } }, { "energy", { 30 } },
+			{ "rotateDelta", { 0.05 } }, { "digDelta", { 0.05 } } };
+	}
+
+	if (type == "swarm")
+	{
+		return { { "agentNum", { 80 } }, { "energy", { 30 } },
+			{ "rotateDelta", { 0.05 } }, { "digDelta", { 0.05 } },
+			{ "roomChance", { 0.0 } }, { "corridorWidth", { 1 } }, { "exploreBias", { 0.0 } } };
+	}
+
+	if (type == "ca")
+	{
+		return { { "iteration", { 5 } }, { "initialWallRate", { 0.45 } }, { "wallCriterionNum", { 5 } } };
+	}
+
+	if (type == "scatter")
+	{
+		return { { "roomSizeMin", { 5 } }, { "roomSizeMax", { 10 } }, { "roomGap", { 2 } },
+			{ "extraEdgeRate", { 0.1 } }, { "roomNumMax", { 0 } } };
+	}
+
+	return {};
+}
+
+static std::vector<double> parseList(const std::string& text)
+{
+	std::vector<double> res;
+	std::stringstream stream(text);
+	std::string item;
+
+	while (std::getline(stream, item, ','))
+	{
+		res.push_back(std::atof(item.c_str()));
+	}
+
+	return res;
+}
+
+//createMap  ð(ms) ȯϰ ǥ   Ѵ. createMap  δ isDone ´.
+template<typename Generator>
+static double measure(Generator& generator, unsigned int seed, OUT bool& isDone, OUT pmg::MapStats& stats)
+{
+	auto begin = std::chrono::steady_clock::now();
+	isDone = generator.createMap(seed);
+	auto end = std::chrono::steady_clock::now();
+
+	stats = pmg::computeStats(generator);
+
+	return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+//values  getDefaultParams .   ǥ  ð  ʴ´.
+static double generate(const std::string& type, int width, int height,
+	const std::vector<double>& v, unsigned int seed, OUT bool& isDone, OUT pmg::MapStats& stats)
+{
+	if (type == "bsp")
+	{
+		pmg::BSP generator(width, height, static_cast<int>(v[0]), static_cast<float>(v[1]),
+			static_cast<float>(v[2]), static_cast<float>(v[3]), static_cast<int>(v[4]));
+		return measure(generator, seed, isDone, stats);
+	}
+
+	if (type == "agent")
+	{
+		pmg::Agent generator(width, height, static_cast<int>(v[0]), static_cast<int>(v[1]),
+			static_cast<float>(v[2]), static_cast<float>(v[3]));
+		return measure(generator, seed, isDone, stats);
+	}
+
+	if (type == "swarm")
+	{
+		pmg::AgentSwarm generator(width, height, static_cast<int>(v[0]), static_cast<int>(v[1]),
+			static_cast<float>(v[2]), static_cast<float>(v[3]));
+		generator.setRoomDrop(static_cast<float>(v[4]), 3, 5);
+		generator.setCorridorWidth(static_cast<int>(v[5]));
+		generator.setExploreBias(static_cast<float>(v[6]));
+		return measure(generator, seed, isDone, stats);
+	}
+
+	if (type == "scatter")
+	{
+		pmg::RoomScatter generator(width, height, static_cast<int>(v[0]), static_cast<int>(v[1]),
+			static_cast<int>(v[2]), static_cast<float>(v[3]));
+		generator.setRoomNumMax(static_cast<int>(v[4]));
+		return measure(generator, seed, isDone, stats);
+	}
+
+	pmg::CellularAutomata generator(width, height, static_cast<int>(v[0]),
+		static_cast<float>(v[1]), static_cast<int>(v[2]));
+	return measure(generator, seed, isDone, stats);
+}
+
+static void writeCsv(std::ostream& stream, const std::vector<Param>& params, const std::vector<Result>& results)
+{
+	for (auto& param : params)
+	{
+		stream << param.mName << ",";
+	}
+
+	stream << "seed,ms,ok,walkableRate,roomNum,hallNum,doorNum,deadEndNum,regionNum,largestRegionRate" << std::endl;
+
+	for (auto& r : results)
+	{
+		for (auto value : r.mValues)
+		{
+			stream << value << ",";
+		}
+
+		stream << r.mSeed << "," << r.mMillisecond << "," << (r.mIsDone ? 1 : 0) << "," << r.mStats.getWalkableRate() << ","
+			<< r.mStats.mRoomNum << "," << r.mStats.mHallNum << "," << r.mStats.mDoorNum << ","
+			<< r.mStats.mDeadEndNum << "," << r.mStats.mRegionNum << ","
+			<< (r.mStats.mWalkableNum > 0 ? static_cast<double>(r.mStats.mLargestRegionNum) / r.mStats.mWalkableNum : 0.0)
+			<< std::endl;
+	}
+}
+
+static void writeJson(std::ostream& stream, const std::vector<Param>& params, const std::vector<Result>& results)
+{
+	stream << "[" << std::endl;
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		auto& r = results[i];
+
+		stream << "  {";
+
+		for (size_t p = 0; p < params.size(); p++)
+		{
+			stream << "\"" << params[p].mName << "\": " << r.mValues[p] << ", ";
+		}
+
+		stream << "\"seed\": " << r.mSeed << ", \"ms\": " << r.mMillisecond
+			<< ", \"ok\": " << (r.mIsDone ? "true" : "false")
+			<< ", \"walkableRate\": " << r.mStats.getWalkableRate()
+			<< ", \"roomNum\": " << r.mStats.mRoomNum
+			<< ", \"hallNum\": " << r.mStats.mHallNum
+			<< ", \"doorNum\": " << r.mStats.mDoorNum
+			<< ", \"deadEndNum\": " << r.mStats.mDeadEndNum
+			<< ", \"regionNum\": " << r.mStats.mRegionNum
+			<< ", \"largestRegionNum\": " << r.mStats.mLargestRegionNum << "}";
+
+		stream << (i + 1 < results.size() ? "," : "") << std::endl;
+	}
+
+	stream << "]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "usage: sweep <bsp|agent|swarm|ca|scatter> [--size WxH] [--seeds N] [--threads N] [--out file.csv|file.json]"
+			" [--param v1,v2,...]..." << std::endl;
+		return 1;
+	}
+
+	std::string type = argv[1];
+	std::vector<Param> params = getDefaultParams(type);
+
+	if (params.empty())
+	{
+		std::cerr << "unknown generator: " << type << std::endl;
+		return 1;
+	}
+
+	int width = 100;
+	int height = 100;
+	int seedNum = 10;
+	int threadNum = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	std::string outPath;
+
+	for (int i = 2; i + 1 < argc; i += 2)
+	{
+		std::string key = argv[i];
+		std::string value = argv[i + 1];
+
+		if (key == "--size")
+		{
+			std::sscanf(value.c_str(), "%dx%d", &width, &height);
+		}
+		else if (key == "--seeds")
+		{
+			seedNum = std::atoi(value.c_str());
+		}
+		else if (key == "--threads")
+		{
+			threadNum = std::max(1, std::atoi(value.c_str()));
+		}
+		else if (key == "--out")
+		{
+			outPath = value;
+		}
+		else
+		{
+			bool isFound = false;
+
+			for (auto& param : params)
+			{
+				if (key == "--" + param.mName)
+				{
+					param.mValues = parseList(value);
+					isFound = true;
+				}
+			}
+
+			if (!isFound)
+			{
+				std::cerr << "unknown option: " << key << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	// Ķ  ģ.
+	std::vector<std::vector<double>> combinations(1);
+
+	for (auto& param : params)
+	{
+		std::vector<std::vector<double>> next;
+
+		for (auto& combination : combinations)
+		{
+			for (auto value : param.mValues)
+			{
+				next.push_back(combination);
+				next.back().push_back(value);
+			}
+		}
+
+		std::swap(combinations, next);
+	}
+
+	std::vector<Result> results(combinations.size() * seedNum);
+	std::atomic<size_t> nextJob(0);
+	std::vector<std::thread> workers;
+
+	for (int t = 0; t < threadNum; t++)
+	{
+		workers.emplace_back([&]()
+		{
+			for (size_t job = nextJob++; job < results.size(); job = nextJob++)
+			{
+				Result& result = results[job];
+
+				result.mValues = combinations[job / seedNum];
+				result.mSeed = static_cast<unsigned int>(job % seedNum);
+
+				result.mMillisecond = generate(type, width, height, result.mValues, result.mSeed,
+					result.mIsDone, result.mStats);
+			}
+		});
+	}
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	if (outPath.empty())
+	{
+		writeCsv(std::cout, params, results);
+		return 0;
+	}
+
+	std::ofstream stream(outPath);
+
+	if (!stream.is_open())
+	{
+		std::cerr << "cannot open " << outPath << std::endl;
+		return 1;
+	}
+
+	if (outPath.size() >= 5 && outPath.compare(outPath.size() - 5, 5, ".json") == 0)
+		writeJson(stream, params, results);
+	else
+		writeCsv(stream, params, results);
+
+	return 0;
+}
\ No newline at end of file